@@ -5,6 +5,24 @@
 // register skinny-128-384+ TBC for benchmark
 BENCHMARK(bench_romulus::skinny_tbc);
 
+// register row-word skinny-128-384+ TBC for benchmark
+BENCHMARK(bench_romulus::skinny_rows_tbc);
+
+// register vectorized skinny-128-384+ TBC for benchmark
+BENCHMARK(bench_romulus::skinny_simd_tbc);
+BENCHMARK(bench_romulus::skinny_simd_tbc_ks);
+BENCHMARK(bench_romulus::skinny_simd_tbc_ts);
+BENCHMARK(bench_romulus::skinny_simd_tbc_pair);
+BENCHMARK(bench_romulus::skinny_simd_tbc2);
+BENCHMARK(bench_romulus::skinny_simd_tbc2x2);
+BENCHMARK(bench_romulus::skinny_simd_tbc2_tk1);
+
+// register bitsliced skinny-128-384+ TBC for benchmark
+BENCHMARK(bench_romulus::skinny_bitsliced_tbc<uint8_t>);
+BENCHMARK(bench_romulus::skinny_bitsliced_tbc<uint16_t>);
+BENCHMARK(bench_romulus::skinny_bitsliced_tbc<uint32_t>);
+BENCHMARK(bench_romulus::skinny_bitsliced_tbc<uint64_t>);
+
 // register Romulus-H hash function for benchmark
 BENCHMARK(bench_romulus::romulush)->Arg(64);
 BENCHMARK(bench_romulus::romulush)->Arg(128);
@@ -14,6 +32,18 @@ BENCHMARK(bench_romulus::romulush)->Arg(1024);
 BENCHMARK(bench_romulus::romulush)->Arg(2048);
 BENCHMARK(bench_romulus::romulush)->Arg(4096);
 
+// register Romulus-H hash function, on many messages, for benchmark
+BENCHMARK(bench_romulus::romulush_many)->Args({64, 256});
+BENCHMARK(bench_romulus::romulush_many)->Args({256, 256});
+BENCHMARK(bench_romulus::romulush_many)->Args({1024, 256});
+
+// register Romulus-H tree hashing mode for benchmark, on 1 MiB to 1 GiB
+// messages, where leaves are hashed using 1 to 16 threads
+BENCHMARK(bench_romulus::romulus_treehash)
+    ->ArgsProduct({benchmark::CreateRange(1 << 20, 1 << 30, 8), {1, 4, 16}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
 // register Romulus-N AEAD routines for benchmark
 BENCHMARK(bench_romulus::romulusn_encrypt)->Args({32, 64});
 BENCHMARK(bench_romulus::romulusn_decrypt)->Args({32, 64});
@@ -30,6 +60,32 @@ BENCHMARK(bench_romulus::romulusn_decrypt)->Args({32, 2048});
 BENCHMARK(bench_romulus::romulusn_encrypt)->Args({32, 4096});
 BENCHMARK(bench_romulus::romulusn_decrypt)->Args({32, 4096});
 
+// register Romulus-N AEAD routines, using precomputed context, for benchmark
+BENCHMARK(bench_romulus::romulusn_encrypt_ctx)->Args({32, 16});
+BENCHMARK(bench_romulus::romulusn_encrypt_ctx)->Args({32, 64});
+BENCHMARK(bench_romulus::romulusn_encrypt_ctx)->Args({32, 1024});
+
+// register Romulus-{N, M, T} AEAD routines, starting from associated data
+// absorbed only once, for benchmark, where last argument selects Romulus-N
+// ( = 0 ), Romulus-M ( = 1 ) or Romulus-T ( = 2 )
+BENCHMARK(bench_romulus::ad_snapshot_encrypt)->Args({200, 64, 0});
+BENCHMARK(bench_romulus::ad_snapshot_encrypt)->Args({200, 1024, 0});
+BENCHMARK(bench_romulus::ad_snapshot_encrypt)->Args({200, 64, 1});
+BENCHMARK(bench_romulus::ad_snapshot_encrypt)->Args({200, 1024, 1});
+BENCHMARK(bench_romulus::ad_snapshot_encrypt)->Args({200, 64, 2});
+BENCHMARK(bench_romulus::ad_snapshot_encrypt)->Args({200, 1024, 2});
+
+// register Romulus-N AEAD routine, on batch of messages, for benchmark, where
+// last argument selects one-by-one ( = 0 ) or batched ( = 1 ) encryption
+BENCHMARK(bench_romulus::romulusn_encrypt_batch)->Args({16, 32, 64, 0});
+BENCHMARK(bench_romulus::romulusn_encrypt_batch)->Args({16, 32, 64, 1});
+BENCHMARK(bench_romulus::romulusn_encrypt_batch)->Args({16, 256, 64, 0});
+BENCHMARK(bench_romulus::romulusn_encrypt_batch)->Args({16, 256, 64, 1});
+BENCHMARK(bench_romulus::romulusn_encrypt_batch)->Args({16, 32, 512, 0});
+BENCHMARK(bench_romulus::romulusn_encrypt_batch)->Args({16, 32, 512, 1});
+BENCHMARK(bench_romulus::romulusn_encrypt_batch)->Args({16, 256, 512, 0});
+BENCHMARK(bench_romulus::romulusn_encrypt_batch)->Args({16, 256, 512, 1});
+
 // register Romulus-M AEAD routines for benchmark
 BENCHMARK(bench_romulus::romulusm_encrypt)->Args({32, 64});
 BENCHMARK(bench_romulus::romulusm_decrypt)->Args({32, 64});
@@ -46,6 +102,23 @@ BENCHMARK(bench_romulus::romulusm_decrypt)->Args({32, 2048});
 BENCHMARK(bench_romulus::romulusm_encrypt)->Args({32, 4096});
 BENCHMARK(bench_romulus::romulusm_decrypt)->Args({32, 4096});
 
+// register Romulus-M AEAD routines for benchmark, on large messages, where
+// encryption reads plain text twice, while decryption touches decrypted text
+// only once, absorbing it into MAC chain while it's still in cache
+BENCHMARK(bench_romulus::romulusm_encrypt)
+    ->ArgsProduct({{32}, benchmark::CreateRange(1 << 20, 1 << 26, 4)})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(bench_romulus::romulusm_decrypt)
+    ->ArgsProduct({{32}, benchmark::CreateRange(1 << 20, 1 << 26, 4)})
+    ->Unit(benchmark::kMillisecond);
+
+// register Romulus-M decryption routine for benchmark, on large messages,
+// isolating effect of fusing decryption and MAC chains on memory traffic, where
+// last argument selects fused ( = 0 ) or unfused, two-pass ( = 1 ) decryption
+BENCHMARK(bench_romulus::romulusm_decrypt_fused)
+    ->ArgsProduct({{32}, benchmark::CreateRange(1 << 20, 1 << 26, 4), {0, 1}})
+    ->Unit(benchmark::kMillisecond);
+
 // register Romulus-T AEAD routines for benchmark
 BENCHMARK(bench_romulus::romulust_encrypt)->Args({32, 64});
 BENCHMARK(bench_romulus::romulust_decrypt)->Args({32, 64});
@@ -62,5 +135,19 @@ BENCHMARK(bench_romulus::romulust_decrypt)->Args({32, 2048});
 BENCHMARK(bench_romulus::romulust_encrypt)->Args({32, 4096});
 BENCHMARK(bench_romulus::romulust_decrypt)->Args({32, 4096});
 
+// register pipelined Romulus-T AEAD routine for benchmark, compared against
+// serial one, on large messages
+BENCHMARK(bench_romulus::romulust_encrypt)->Args({32, 1 << 20})->UseRealTime();
+BENCHMARK(bench_romulus::romulust_encrypt_pipelined)
+    ->Args({32, 1 << 20})
+    ->UseRealTime();
+
+// register segmented Romulus-N AEAD for benchmark, on 1 GiB plain text, split
+// into 1 MiB segments, sealed using 1 to 64 threads
+BENCHMARK(bench_romulus::segmented_seal_parallel)
+    ->ArgsProduct({{0}, {1 << 30}, {1 << 20}, {1, 2, 4, 8, 16, 32, 64}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
 // benchmark runner main function
 BENCHMARK_MAIN();
@@ -0,0 +1,424 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+#include "romulush.hpp"
+#include "romulusm.hpp"
+#include "romulusn.hpp"
+#include "romulust.hpp"
+#include "treehash.hpp"
+#include "utils.hpp"
+
+// Command line tool for hashing files using Romulus-H ( or its tree hashing
+// mode ) and sealing/ opening files using Romulus-{N, M, T}, where input file
+// is memory mapped, with sequential access hint, and output file is memory
+// mapped and written in place. Output is first written to a temporary file,
+// next to it, which is renamed to output path, only once it's complete, while
+// opened plain text is only written, once it's verified.
+//
+// Sealed file is laid out as 16 -bytes random nonce || encrypted text || 16
+// -bytes authentication tag, while secret key is read from a 16 -bytes file.
+//
+// Build it with `make cli/a.out`.
+
+// Bytes fed to incremental hasher/ Romulus-N stream at a time
+constexpr size_t CHUNK_LEN = 1ul << 20;
+
+// Memory mapped file, where `ptr` is null, when file is empty
+struct mapping_t {
+  uint8_t* ptr;
+  size_t len;
+  int fd;  // kept open only for output file, until it's committed, else -1
+};
+
+// Prints error message, along with reason of last failed system call, if any,
+// and terminates program
+[[noreturn]] static void fail(const std::string& msg) {
+  if (errno != 0) {
+    std::cerr << "error: " << msg << ": " << std::strerror(errno) << std::endl;
+  } else {
+    std::cerr << "error: " << msg << std::endl;
+  }
+  std::exit(EXIT_FAILURE);
+}
+
+// Maps whole file for reading, advising kernel that it's read sequentially
+static mapping_t map_input(const char* const path) {
+  const int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    fail(std::string("can't open ") + path);
+  }
+
+  struct stat sb;
+  if (fstat(fd, &sb) != 0) {
+    fail(std::string("can't stat ") + path);
+  }
+
+  mapping_t m{nullptr, static_cast<size_t>(sb.st_size), -1};
+
+  if (m.len > 0) {
+    void* p = mmap(nullptr, m.len, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (p == MAP_FAILED) {
+      fail(std::string("can't map ") + path);
+    }
+
+    madvise(p, m.len, MADV_SEQUENTIAL);
+    m.ptr = static_cast<uint8_t*>(p);
+  }
+
+  close(fd);
+  return m;
+}
+
+// Removes temporary output file, while preserving reason of failed system call,
+// which led to it
+static void discard(const std::string& tmp) {
+  const int err = errno;
+  unlink(tmp.c_str());
+  errno = err;
+}
+
+// Creates temporary file of given length, next to output path, whose name is
+// written to `tmp`, and maps it for writing, advising kernel that it's written
+// sequentially. File stays open, so that it can be flushed to disk, before it's
+// committed. See `commit` and `discard`.
+static mapping_t map_output(const char* const path,
+                            const size_t len,
+                            std::string* const tmp) {
+  *tmp = std::string(path) + ".XXXXXX";
+
+  const int fd = mkstemp(tmp->data());
+  if (fd < 0) {
+    fail(std::string("can't create ") + *tmp);
+  }
+
+  if (ftruncate(fd, static_cast<off_t>(len)) != 0) {
+    discard(*tmp);
+    fail(std::string("can't resize ") + *tmp);
+  }
+
+  mapping_t m{nullptr, len, fd};
+
+  if (m.len > 0) {
+    void* p = mmap(nullptr, m.len, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED) {
+      discard(*tmp);
+      fail(std::string("can't map ") + *tmp);
+    }
+
+    madvise(p, m.len, MADV_SEQUENTIAL);
+    m.ptr = static_cast<uint8_t*>(p);
+  }
+
+  return m;
+}
+
+// Maps anonymous memory of given length, private to this process, where
+// plain text is kept, until it's verified
+static mapping_t map_scratch(const size_t len) {
+  mapping_t m{nullptr, len, -1};
+
+  if (m.len > 0) {
+    void* p = mmap(nullptr, m.len, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) {
+      fail("can't allocate scratch memory");
+    }
+
+    m.ptr = static_cast<uint8_t*>(p);
+  }
+
+  return m;
+}
+
+static void unmap(const mapping_t& m) {
+  if (m.ptr != nullptr) {
+    munmap(m.ptr, m.len);
+  }
+}
+
+// Flushes completely written temporary file to disk, unmapping and closing it,
+// and only then atomically replaces output file with it, so that a crash never
+// leaves partially written file at output path
+static void commit(const mapping_t& out,
+                   const std::string& tmp,
+                   const char* const path) {
+  if ((out.ptr != nullptr) && (msync(out.ptr, out.len, MS_SYNC) != 0)) {
+    discard(tmp);
+    fail(std::string("can't flush ") + tmp);
+  }
+
+  unmap(out);
+
+  if (fsync(out.fd) != 0) {
+    discard(tmp);
+    fail(std::string("can't flush ") + tmp);
+  }
+
+  close(out.fd);
+
+  if (std::rename(tmp.c_str(), path) != 0) {
+    discard(tmp);
+    fail(std::string("can't rename ") + tmp + " to " + path);
+  }
+}
+
+// Checks whether both paths name same file, which can't be both input and
+// output
+static bool same_file(const char* const ipath, const char* const opath) {
+  struct stat a;
+  struct stat b;
+
+  if ((stat(ipath, &a) != 0) || (stat(opath, &b) != 0)) {
+    errno = 0;
+    return false;
+  }
+
+  return (a.st_dev == b.st_dev) && (a.st_ino == b.st_ino);
+}
+
+// Reads 16 -bytes secret key from given file
+static void read_key(const char* const path, uint8_t* const key) {
+  const mapping_t m = map_input(path);
+  if (m.len != 16) {
+    errno = 0;
+    fail(std::string("key file must be 16 -bytes long: ") + path);
+  }
+
+  std::memcpy(key, m.ptr, 16);
+  unmap(m);
+}
+
+// Samples 16 -bytes nonce from operating system's random number generator, as
+// `random_data` expands only 32 -bit seed, which isn't enough for a nonce
+static void random_nonce(uint8_t* const nonce) {
+  std::random_device rd;
+
+  for (size_t i = 0; i < 16; i += 4) {
+    const uint32_t w = rd();
+    std::memcpy(nonce + i, &w, 4);
+  }
+}
+
+// Prints number of bytes processed and throughput, since `start`
+static void report(const char* const what,
+                   const size_t len,
+                   const std::chrono::steady_clock::time_point start) {
+  const auto end = std::chrono::steady_clock::now();
+  const double secs = std::chrono::duration<double>(end - start).count();
+  const double mbps = secs > 0 ? static_cast<double>(len) / secs / 1e6 : 0;
+
+  std::cerr << what << " " << len << " bytes in " << secs << " s, " << mbps
+            << " MB/s" << std::endl;
+}
+
+// Computes Romulus-H digest ( or tree hash digest, on given number of threads
+// ) of file
+static void hash_file(const char* const path, const bool tree, size_t threads) {
+  const mapping_t in = map_input(path);
+  const auto start = std::chrono::steady_clock::now();
+
+  uint8_t dig[32];
+
+  if (tree) {
+    romulus_treehash::hash(in.ptr, in.len, dig, threads);
+  } else {
+    romulush::hasher_t hasher;
+    romulush::init(&hasher);
+
+    for (size_t off = 0; off < in.len; off += CHUNK_LEN) {
+      const size_t len = std::min(CHUNK_LEN, in.len - off);
+      romulush::absorb(&hasher, in.ptr + off, len);
+    }
+
+    romulush::finalize(&hasher, dig);
+  }
+
+  report("hashed", in.len, start);
+  std::cout << to_hex(dig, sizeof(dig)) << "  " << path << std::endl;
+
+  unmap(in);
+}
+
+// Seals file using chosen Romulus AEAD scheme, under random nonce, without any
+// associated data
+static void seal_file(const char scheme,
+                      const uint8_t* const key,
+                      const char* const ipath,
+                      const char* const opath) {
+  std::string tmp;
+
+  const mapping_t in = map_input(ipath);
+  const mapping_t out = map_output(opath, in.len + 32, &tmp);
+  const auto start = std::chrono::steady_clock::now();
+
+  uint8_t* const nonce = out.ptr;
+  uint8_t* const cipher = out.ptr + 16;
+  uint8_t* const tag = out.ptr + 16 + in.len;
+
+  random_nonce(nonce);
+
+  if (scheme == 'n') {
+    romulusn::context_t ctx;
+    romulusn::setup(&ctx, key);
+
+    romulusn::stream_t strm;
+    romulusn::init(&strm, &ctx, nonce);
+
+    for (size_t off = 0; off < in.len; off += CHUNK_LEN) {
+      const size_t len = std::min(CHUNK_LEN, in.len - off);
+      romulusn::encrypt_update(&strm, in.ptr + off, cipher + off, len);
+    }
+
+    romulusn::finalize(&strm, tag);
+  } else if (scheme == 'm') {
+    romulusm::encrypt(key, nonce, nullptr, 0, in.ptr, cipher, in.len, tag);
+  } else {
+    romulust::encrypt(key, nonce, nullptr, 0, in.ptr, cipher, in.len, tag);
+  }
+
+  report("sealed", in.len, start);
+
+  unmap(in);
+  commit(out, tmp, opath);
+}
+
+// Opens file sealed using chosen Romulus AEAD scheme, where plain text is
+// decrypted into private memory, as Romulus-{N, M} decrypt before verifying,
+// and output file is only written, if verification succeeds
+static bool open_file(const char scheme,
+                      const uint8_t* const key,
+                      const char* const ipath,
+                      const char* const opath) {
+  const mapping_t in = map_input(ipath);
+  if (in.len < 32) {
+    errno = 0;
+    fail(std::string("sealed file is too short: ") + ipath);
+  }
+
+  const size_t ctlen = in.len - 32;
+  const mapping_t txt = map_scratch(ctlen);
+  const auto start = std::chrono::steady_clock::now();
+
+  const uint8_t* const nonce = in.ptr;
+  const uint8_t* const cipher = in.ptr + 16;
+  const uint8_t* const tag = in.ptr + 16 + ctlen;
+
+  bool f = false;
+
+  if (scheme == 'n') {
+    romulusn::context_t ctx;
+    romulusn::setup(&ctx, key);
+
+    romulusn::stream_t strm;
+    romulusn::init(&strm, &ctx, nonce);
+
+    for (size_t off = 0; off < ctlen; off += CHUNK_LEN) {
+      const size_t len = std::min(CHUNK_LEN, ctlen - off);
+      romulusn::decrypt_update(&strm, cipher + off, txt.ptr + off, len);
+    }
+
+    f = romulusn::verify(&strm, tag);
+  } else if (scheme == 'm') {
+    f = romulusm::decrypt(key, nonce, tag, nullptr, 0, cipher, txt.ptr, ctlen);
+  } else {
+    f = romulust::decrypt(key, nonce, tag, nullptr, 0, cipher, txt.ptr, ctlen);
+  }
+
+  if (f) {
+    std::string tmp;
+    const mapping_t out = map_output(opath, ctlen, &tmp);
+
+    if (ctlen > 0) {
+      std::memcpy(out.ptr, txt.ptr, ctlen);
+    }
+
+    commit(out, tmp, opath);
+  }
+
+  report("opened", ctlen, start);
+
+  unmap(in);
+  unmap(txt);
+
+  return f;
+}
+
+[[noreturn]] static void usage() {
+  std::cerr << "usage:" << std::endl
+            << "  a.out hash <file>" << std::endl
+            << "  a.out treehash <file> [threads]" << std::endl
+            << "  a.out seal <n|m|t> <key-file> <in-file> <out-file>"
+            << std::endl
+            << "  a.out open <n|m|t> <key-file> <in-file> <out-file>"
+            << std::endl;
+  std::exit(EXIT_FAILURE);
+}
+
+int main(int argc, char** argv) {
+  if (argc < 3) {
+    usage();
+  }
+
+  const std::string cmd = argv[1];
+
+  if (cmd == "hash" && argc == 3) {
+    hash_file(argv[2], false, 1);
+    return EXIT_SUCCESS;
+  }
+
+  if (cmd == "treehash" && (argc == 3 || argc == 4)) {
+    size_t threads = 0;
+
+    if (argc == 4) {
+      try {
+        threads = std::stoul(argv[3]);
+      } catch (const std::exception&) {
+        usage();
+      }
+    }
+
+    hash_file(argv[2], true, threads);
+    return EXIT_SUCCESS;
+  }
+
+  if ((cmd == "seal" || cmd == "open") && argc == 6) {
+    const std::string scheme = argv[2];
+    if (scheme != "n" && scheme != "m" && scheme != "t") {
+      usage();
+    }
+
+    if (same_file(argv[4], argv[5])) {
+      errno = 0;
+      fail("input and output must be different files");
+    }
+
+    uint8_t key[16];
+    read_key(argv[3], key);
+
+    if (cmd == "seal") {
+      seal_file(scheme[0], key, argv[4], argv[5]);
+      return EXIT_SUCCESS;
+    }
+
+    if (!open_file(scheme[0], key, argv[4], argv[5])) {
+      std::cerr << "error: verification failed" << std::endl;
+      return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+  }
+
+  usage();
+}
@@ -6,6 +6,7 @@
 #include "romulusm.hpp"
 #include "romulusn.hpp"
 #include "romulust.hpp"
+#include "segmented.hpp"
 #include "utils.hpp"
 
 // Benchmark Romulus AEAD/ Hash routines on CPU
@@ -66,6 +67,232 @@ static void romulusn_encrypt(benchmark::State &state) {
   std::free(dec);
 }
 
+// Benchmarks Romulus-N authenticated encryption routine on CPU, with variable
+// length associated data and plain text bytes, using a context prepared once
+static void romulusn_encrypt_ctx(benchmark::State &state) {
+  constexpr size_t kntlen = 16;
+
+  const size_t dlen = state.range(0);
+  const size_t ctlen = state.range(1);
+
+  uint8_t *key = static_cast<uint8_t *>(std::malloc(kntlen));
+  uint8_t *nonce = static_cast<uint8_t *>(std::malloc(kntlen));
+  uint8_t *tag = static_cast<uint8_t *>(std::malloc(kntlen));
+  uint8_t *data = static_cast<uint8_t *>(std::malloc(dlen));
+  uint8_t *txt = static_cast<uint8_t *>(std::malloc(ctlen));
+  uint8_t *enc = static_cast<uint8_t *>(std::malloc(ctlen));
+  uint8_t *dec = static_cast<uint8_t *>(std::malloc(ctlen));
+
+  random_data(key, kntlen);
+  random_data(nonce, kntlen);
+  random_data(data, dlen);
+  random_data(txt, ctlen);
+
+  std::memset(tag, 0, kntlen);
+  std::memset(enc, 0, ctlen);
+  std::memset(dec, 0, ctlen);
+
+  romulusn::context_t ctx;
+  romulusn::setup(&ctx, key);
+
+  for (auto _ : state) {
+    romulusn::encrypt(&ctx, nonce, data, dlen, txt, enc, ctlen, tag);
+
+    benchmark::DoNotOptimize(enc);
+    benchmark::DoNotOptimize(tag);
+    benchmark::ClobberMemory();
+  }
+
+  bool f = false;
+  f = romulusn::decrypt(&ctx, nonce, tag, data, dlen, enc, dec, ctlen);
+  assert(f);
+
+  for (size_t i = 0; i < ctlen; i++) {
+    assert((txt[i] ^ dec[i]) == 0);
+  }
+
+  const size_t per_itr_data = dlen + ctlen;
+  const size_t total_data = per_itr_data * state.iterations();
+
+  state.SetBytesProcessed(static_cast<int64_t>(total_data));
+
+  std::free(key);
+  std::free(nonce);
+  std::free(tag);
+  std::free(data);
+  std::free(txt);
+  std::free(enc);
+  std::free(dec);
+}
+
+// Benchmarks Romulus-{N, M, T} authenticated encryption routines on CPU, with
+// variable length associated data and plain text bytes, where associated data
+// is absorbed only once ( say a fixed protocol header ) and each message starts
+// from it, selecting Romulus-N, Romulus-M or Romulus-T, when third argument is
+// 0, 1 or 2, respectively
+static void ad_snapshot_encrypt(benchmark::State &state) {
+  constexpr size_t kntlen = 16;
+
+  const size_t dlen = state.range(0);
+  const size_t ctlen = state.range(1);
+  const size_t scheme = state.range(2);
+
+  uint8_t *key = static_cast<uint8_t *>(std::malloc(kntlen));
+  uint8_t *nonce = static_cast<uint8_t *>(std::malloc(kntlen));
+  uint8_t *tag = static_cast<uint8_t *>(std::malloc(kntlen));
+  uint8_t *data = static_cast<uint8_t *>(std::malloc(dlen));
+  uint8_t *txt = static_cast<uint8_t *>(std::malloc(ctlen));
+  uint8_t *enc = static_cast<uint8_t *>(std::malloc(ctlen));
+  uint8_t *dec = static_cast<uint8_t *>(std::malloc(ctlen));
+
+  random_data(key, kntlen);
+  random_data(nonce, kntlen);
+  random_data(data, dlen);
+  random_data(txt, ctlen);
+
+  std::memset(tag, 0, kntlen);
+  std::memset(enc, 0, ctlen);
+  std::memset(dec, 0, ctlen);
+
+  romulusn::context_t ctx;
+  romulusn::setup(&ctx, key);
+
+  skinny::key_schedule_t ks;
+  skinny::expand_tk3(&ks, key);
+
+  romulusn::ad_snapshot_t nsnap;
+  romulusm::ad_snapshot_t msnap;
+  romulust::ad_checkpoint_t tckpt;
+
+  romulusn::absorb(&nsnap, &ctx, data, dlen);
+  romulusm::absorb(&msnap, &ks, data, dlen);
+  romulust::absorb(&tckpt, data, dlen);
+
+  for (auto _ : state) {
+    if (scheme == 0) {
+      romulusn::encrypt(&ctx, &nsnap, nonce, txt, enc, ctlen, tag);
+    } else if (scheme == 1) {
+      romulusm::encrypt(&ks, &msnap, nonce, txt, enc, ctlen, tag);
+    } else {
+      romulust::encrypt(key, &tckpt, nonce, txt, enc, ctlen, tag);
+    }
+
+    benchmark::DoNotOptimize(enc);
+    benchmark::DoNotOptimize(tag);
+    benchmark::ClobberMemory();
+  }
+
+  bool f = false;
+  if (scheme == 0) {
+    f = romulusn::decrypt(&ctx, nonce, tag, data, dlen, enc, dec, ctlen);
+  } else if (scheme == 1) {
+    f = romulusm::decrypt(key, nonce, tag, data, dlen, enc, dec, ctlen);
+  } else {
+    f = romulust::decrypt(key, nonce, tag, data, dlen, enc, dec, ctlen);
+  }
+  assert(f);
+
+  for (size_t i = 0; i < ctlen; i++) {
+    assert((txt[i] ^ dec[i]) == 0);
+  }
+
+  const size_t per_itr_data = dlen + ctlen;
+  const size_t total_data = per_itr_data * state.iterations();
+
+  state.SetBytesProcessed(static_cast<int64_t>(total_data));
+
+  std::free(key);
+  std::free(nonce);
+  std::free(tag);
+  std::free(data);
+  std::free(txt);
+  std::free(enc);
+  std::free(dec);
+}
+
+// Benchmarks Romulus-N authenticated encryption routine on CPU, applied on a
+// batch of messages ( with same length associated data and plain text bytes ),
+// under same secret key, comparing one-by-one encryption ( when third argument
+// is 0 ) against batched encryption, reporting messages/s
+static void romulusn_encrypt_batch(benchmark::State &state) {
+  constexpr size_t kntlen = 16;
+
+  const size_t dlen = state.range(0);
+  const size_t ctlen = state.range(1);
+  const size_t cnt = state.range(2);
+  const bool batched = state.range(3) != 0;
+
+  uint8_t *key = static_cast<uint8_t *>(std::malloc(kntlen));
+  uint8_t *nonce = static_cast<uint8_t *>(std::malloc(kntlen * cnt));
+  uint8_t *tag = static_cast<uint8_t *>(std::malloc(kntlen * cnt));
+  uint8_t *data = static_cast<uint8_t *>(std::malloc(dlen * cnt));
+  uint8_t *txt = static_cast<uint8_t *>(std::malloc(ctlen * cnt));
+  uint8_t *enc = static_cast<uint8_t *>(std::malloc(ctlen * cnt));
+  uint8_t *dec = static_cast<uint8_t *>(std::malloc(ctlen));
+
+  random_data(key, kntlen);
+  random_data(nonce, kntlen * cnt);
+  random_data(data, dlen * cnt);
+  random_data(txt, ctlen * cnt);
+
+  std::memset(tag, 0, kntlen * cnt);
+  std::memset(enc, 0, ctlen * cnt);
+
+  romulusn::context_t ctx;
+  romulusn::setup(&ctx, key);
+
+  romulusn::message_t *msgs = static_cast<romulusn::message_t *>(
+      std::malloc(sizeof(romulusn::message_t) * cnt));
+
+  for (size_t i = 0; i < cnt; i++) {
+    msgs[i] = {nonce + i * kntlen, data + i * dlen, dlen, txt + i * ctlen,
+               enc + i * ctlen,    ctlen,           tag + i * kntlen};
+  }
+
+  for (auto _ : state) {
+    if (batched) {
+      romulusn::encrypt_batch(&ctx, msgs, cnt);
+    } else {
+      for (size_t i = 0; i < cnt; i++) {
+        const romulusn::message_t *m = msgs + i;
+        romulusn::encrypt(&ctx, m->nonce, m->data, m->dlen, m->src, m->dst,
+                          m->len, m->tag);
+      }
+    }
+
+    benchmark::DoNotOptimize(enc);
+    benchmark::DoNotOptimize(tag);
+    benchmark::ClobberMemory();
+  }
+
+  for (size_t i = 0; i < cnt; i++) {
+    bool f = false;
+    f = romulusn::decrypt(&ctx, nonce + i * kntlen, tag + i * kntlen,
+                          data + i * dlen, dlen, enc + i * ctlen, dec, ctlen);
+    assert(f);
+
+    for (size_t j = 0; j < ctlen; j++) {
+      assert((txt[i * ctlen + j] ^ dec[j]) == 0);
+    }
+  }
+
+  const size_t total_msgs = cnt * state.iterations();
+  const size_t total_data = (dlen + ctlen) * total_msgs;
+
+  state.SetBytesProcessed(static_cast<int64_t>(total_data));
+  state.counters["messages/s"] = benchmark::Counter(
+      static_cast<double>(total_msgs), benchmark::Counter::kIsRate);
+
+  std::free(key);
+  std::free(nonce);
+  std::free(tag);
+  std::free(data);
+  std::free(txt);
+  std::free(enc);
+  std::free(dec);
+  std::free(msgs);
+}
+
 // Benchmarks Romulus-N verified decryption routine on CPU, with variable
 // length associated data and plain/ cipher text bytes
 static void romulusn_decrypt(benchmark::State &state) {
@@ -229,6 +456,74 @@ static void romulusm_decrypt(benchmark::State &state) {
   std::free(dec);
 }
 
+// Benchmarks Romulus-M verified decryption routine on CPU, starting from
+// associated data absorbed only once, comparing fused decryption, where MAC
+// chain trails decryption chain by at most romulusm::FUSE_WINDOW -bytes ( when
+// third argument is 0 ), against unfused one, where whole text is decrypted
+// before MAC chain reads it back from memory, in a second pass, so that only
+// memory traffic of decrypted text differs
+static void romulusm_decrypt_fused(benchmark::State &state) {
+  constexpr size_t kntlen = 16;
+
+  const size_t dlen = state.range(0);
+  const size_t ctlen = state.range(1);
+  const bool fused = state.range(2) == 0;
+
+  uint8_t *key = static_cast<uint8_t *>(std::malloc(kntlen));
+  uint8_t *nonce = static_cast<uint8_t *>(std::malloc(kntlen));
+  uint8_t *tag = static_cast<uint8_t *>(std::malloc(kntlen));
+  uint8_t *data = static_cast<uint8_t *>(std::malloc(dlen));
+  uint8_t *txt = static_cast<uint8_t *>(std::malloc(ctlen));
+  uint8_t *enc = static_cast<uint8_t *>(std::malloc(ctlen));
+  uint8_t *dec = static_cast<uint8_t *>(std::malloc(ctlen));
+
+  random_data(key, kntlen);
+  random_data(nonce, kntlen);
+  random_data(data, dlen);
+  random_data(txt, ctlen);
+
+  std::memset(tag, 0, kntlen);
+  std::memset(enc, 0, ctlen);
+  std::memset(dec, 0, ctlen);
+
+  skinny::key_schedule_t ks;
+  skinny::expand_tk3(&ks, key);
+
+  romulusm::ad_snapshot_t snap;
+  romulusm::absorb(&snap, &ks, data, dlen);
+
+  romulusm::encrypt(&ks, &snap, nonce, txt, enc, ctlen, tag);
+
+  const size_t window = fused ? romulusm::FUSE_WINDOW : ctlen;
+
+  for (auto _ : state) {
+    romulus_common::blocks_t it;
+    romulusm::init_blocks(&it, &snap, dec, ctlen);
+
+    bool f = false;
+    f = romulusm::decrypt(&ks, nonce, tag, &snap, &it, 1ul * snap.odd, enc,
+                          dec, ctlen, window);
+
+    benchmark::DoNotOptimize(f);
+    benchmark::DoNotOptimize(dec);
+    benchmark::ClobberMemory();
+  }
+
+  for (size_t i = 0; i < ctlen; i++) {
+    assert((txt[i] ^ dec[i]) == 0);
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(ctlen * state.iterations()));
+
+  std::free(key);
+  std::free(nonce);
+  std::free(tag);
+  std::free(data);
+  std::free(txt);
+  std::free(enc);
+  std::free(dec);
+}
+
 // Benchmarks Romulus-T authenticated encryption routine on CPU, with variable
 // length associated data and plain text bytes
 static void romulust_encrypt(benchmark::State &state) {
@@ -284,6 +579,62 @@ static void romulust_encrypt(benchmark::State &state) {
   std::free(dec);
 }
 
+// Benchmarks pipelined Romulus-T authenticated encryption routine on CPU, with
+// variable length associated data and plain text bytes, where keystream is
+// generated on a second thread, while encrypted text is being hashed
+static void romulust_encrypt_pipelined(benchmark::State &state) {
+  constexpr size_t kntlen = 16;
+
+  const size_t dlen = state.range(0);
+  const size_t ctlen = state.range(1);
+
+  uint8_t *key = static_cast<uint8_t *>(std::malloc(kntlen));
+  uint8_t *nonce = static_cast<uint8_t *>(std::malloc(kntlen));
+  uint8_t *tag = static_cast<uint8_t *>(std::malloc(kntlen));
+  uint8_t *data = static_cast<uint8_t *>(std::malloc(dlen));
+  uint8_t *txt = static_cast<uint8_t *>(std::malloc(ctlen));
+  uint8_t *enc = static_cast<uint8_t *>(std::malloc(ctlen));
+  uint8_t *dec = static_cast<uint8_t *>(std::malloc(ctlen));
+
+  random_data(key, kntlen);
+  random_data(nonce, kntlen);
+  random_data(data, dlen);
+  random_data(txt, ctlen);
+
+  std::memset(tag, 0, kntlen);
+  std::memset(enc, 0, ctlen);
+  std::memset(dec, 0, ctlen);
+
+  for (auto _ : state) {
+    romulust::encrypt_pipelined(key, nonce, data, dlen, txt, enc, ctlen, tag);
+
+    benchmark::DoNotOptimize(enc);
+    benchmark::DoNotOptimize(tag);
+    benchmark::ClobberMemory();
+  }
+
+  bool f = false;
+  f = romulust::decrypt(key, nonce, tag, data, dlen, enc, dec, ctlen);
+  assert(f);
+
+  for (size_t i = 0; i < ctlen; i++) {
+    assert((txt[i] ^ dec[i]) == 0);
+  }
+
+  const size_t per_itr_data = dlen + ctlen;
+  const size_t total_data = per_itr_data * state.iterations();
+
+  state.SetBytesProcessed(static_cast<int64_t>(total_data));
+
+  std::free(key);
+  std::free(nonce);
+  std::free(tag);
+  std::free(data);
+  std::free(txt);
+  std::free(enc);
+  std::free(dec);
+}
+
 // Benchmarks Romulus-T verified decryption routine on CPU, with variable
 // length associated data and plain/ cipher text bytes
 static void romulust_decrypt(benchmark::State &state) {
@@ -338,4 +689,67 @@ static void romulust_decrypt(benchmark::State &state) {
   std::free(dec);
 }
 
+// Benchmarks segmented container mode on CPU, sealing plain text of given
+// length, split into segments of given length, using chosen Romulus AEAD
+// scheme, on given number of threads
+static void segmented_seal_parallel(benchmark::State &state) {
+  constexpr size_t kntlen = 16;
+  constexpr size_t dlen = 32;
+
+  const auto aead = static_cast<romulus_segmented::aead_t>(state.range(0));
+  const size_t ctlen = state.range(1);
+  const size_t seg_len = state.range(2);
+  const size_t threads = state.range(3);
+
+  const size_t slen = romulus_segmented::sealed_len(ctlen, seg_len);
+
+  uint8_t *key = static_cast<uint8_t *>(std::malloc(kntlen));
+  uint8_t *nonce = static_cast<uint8_t *>(std::malloc(kntlen));
+  uint8_t *data = static_cast<uint8_t *>(std::malloc(dlen));
+  uint8_t *txt = static_cast<uint8_t *>(std::malloc(ctlen));
+  uint8_t *sealed = static_cast<uint8_t *>(std::malloc(slen));
+  uint8_t *dec = static_cast<uint8_t *>(std::malloc(seg_len));
+
+  random_data(key, kntlen);
+  random_data(nonce, kntlen);
+  random_data(data, dlen);
+  random_data(txt, ctlen);
+
+  std::memset(sealed, 0, slen);
+
+  romulus_segmented::context_t k;
+  romulus_segmented::setup(&k, aead, key);
+
+  for (auto _ : state) {
+    romulus_segmented::seal_parallel(&k, nonce, data, dlen, txt, ctlen, seg_len,
+                                     sealed, threads);
+
+    benchmark::DoNotOptimize(sealed);
+    benchmark::ClobberMemory();
+  }
+
+  // only last segment is verified, as opening whole plain text takes as long
+  const size_t off = ctlen - std::min(ctlen, seg_len);
+  const size_t len = ctlen - off;
+
+  bool f = false;
+  f = romulus_segmented::open_range(&k, nonce, data, dlen, sealed, slen,
+                                    seg_len, off, dec, len);
+  assert(f);
+
+  for (size_t i = 0; i < len; i++) {
+    assert((txt[off + i] ^ dec[i]) == 0);
+  }
+
+  const size_t total_data = (dlen + ctlen) * state.iterations();
+  state.SetBytesProcessed(static_cast<int64_t>(total_data));
+
+  std::free(key);
+  std::free(nonce);
+  std::free(data);
+  std::free(txt);
+  std::free(sealed);
+  std::free(dec);
+}
+
 }  // namespace bench_romulus
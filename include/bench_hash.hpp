@@ -2,6 +2,7 @@
 #include <benchmark/benchmark.h>
 
 #include "romulush.hpp"
+#include "treehash.hpp"
 #include "utils.hpp"
 
 // Benchmark Romulus AEAD/ Hash routines on CPU
@@ -31,4 +32,72 @@ static void romulush(benchmark::State& state) {
   std::free(dig);
 }
 
+// Benchmarks Romulus-H hash function on CPU, when hashing many independent
+// messages ( of same length ) together, using multi-block Skinny-128-384+
+static void romulush_many(benchmark::State& state) {
+  const size_t mlen = state.range(0);
+  const size_t cnt = state.range(1);
+  constexpr size_t dlen = 32;
+
+  uint8_t* msg = static_cast<uint8_t*>(std::malloc(mlen * cnt));
+  uint8_t* dig = static_cast<uint8_t*>(std::malloc(dlen * cnt));
+
+  const uint8_t** msgs =
+      static_cast<const uint8_t**>(std::malloc(sizeof(uint8_t*) * cnt));
+  uint8_t** digs = static_cast<uint8_t**>(std::malloc(sizeof(uint8_t*) * cnt));
+  size_t* mlens = static_cast<size_t*>(std::malloc(sizeof(size_t) * cnt));
+
+  random_data(msg, mlen * cnt);
+
+  for (size_t i = 0; i < cnt; i++) {
+    msgs[i] = msg + i * mlen;
+    digs[i] = dig + i * dlen;
+    mlens[i] = mlen;
+  }
+
+  for (auto _ : state) {
+    romulush::hash_many(msgs, mlens, digs, cnt);
+
+    benchmark::DoNotOptimize(dig);
+    benchmark::ClobberMemory();
+  }
+
+  const size_t total = cnt * state.iterations();
+
+  state.SetBytesProcessed(static_cast<int64_t>(mlen * total));
+  state.counters["messages/s"] =
+      benchmark::Counter(static_cast<double>(total), benchmark::Counter::kIsRate);
+
+  std::free(msg);
+  std::free(dig);
+  std::free(msgs);
+  std::free(digs);
+  std::free(mlens);
+}
+
+// Benchmarks tree hashing mode on top of Romulus-H on CPU, for given message
+// length, where leaves are hashed on given number of threads
+static void romulus_treehash(benchmark::State& state) {
+  const size_t mlen = state.range(0);
+  const size_t threads = state.range(1);
+  constexpr size_t dlen = 32;
+
+  uint8_t* msg = static_cast<uint8_t*>(std::malloc(mlen));
+  uint8_t* dig = static_cast<uint8_t*>(std::malloc(dlen));
+
+  random_data(msg, mlen);
+
+  for (auto _ : state) {
+    romulus_treehash::hash(msg, mlen, dig, threads);
+
+    benchmark::DoNotOptimize(dig);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(mlen * state.iterations()));
+
+  std::free(msg);
+  std::free(dig);
+}
+
 }  // namespace bench_romulus
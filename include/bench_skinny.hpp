@@ -2,6 +2,9 @@
 #include <benchmark/benchmark.h>
 
 #include "skinny.hpp"
+#include "skinny_bitsliced.hpp"
+#include "skinny_rows.hpp"
+#include "skinny_simd.hpp"
 #include "utils.hpp"
 
 // Benchmark Romulus AEAD/ Hash routines on CPU
@@ -34,4 +37,279 @@ static void skinny_tbc(benchmark::State& state) {
   std::free(key);
 }
 
+// Benchmarks Skinny-128-384+ tweakable block cipher on CPU, keeping each row of
+// internal state in a 32 -bit word
+static void skinny_rows_tbc(benchmark::State& state) {
+  constexpr size_t N = 16;
+  constexpr size_t T = 3 * N;
+
+  uint8_t* txt = static_cast<uint8_t*>(std::malloc(N));
+  uint8_t* key = static_cast<uint8_t*>(std::malloc(T));
+
+  random_data(txt, N);
+  random_data(key, T);
+
+  skinny::state_t st;
+  skinny::initialize(&st, txt, key);
+
+  for (auto _ : state) {
+    skinny_rows::tbc(&st);
+
+    benchmark::DoNotOptimize(st);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(N * state.iterations()));
+
+  std::free(txt);
+  std::free(key);
+}
+
+// Benchmarks Skinny-128-384+ tweakable block cipher on CPU, using
+// implementation picked by run time dispatcher
+static void skinny_simd_tbc(benchmark::State& state) {
+  constexpr size_t N = 16;
+  constexpr size_t T = 3 * N;
+
+  uint8_t* txt = static_cast<uint8_t*>(std::malloc(N));
+  uint8_t* key = static_cast<uint8_t*>(std::malloc(T));
+
+  random_data(txt, N);
+  random_data(key, T);
+
+  skinny::state_t st;
+  skinny::initialize(&st, txt, key);
+
+  for (auto _ : state) {
+    skinny_simd::tbc(&st);
+
+    benchmark::DoNotOptimize(st);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(N * state.iterations()));
+
+  std::free(txt);
+  std::free(key);
+}
+
+// Benchmarks Skinny-128-384+ tweakable block cipher on CPU, using
+// implementation picked by run time dispatcher, where tweakey state (3) is
+// already expanded into round tweakeys
+static void skinny_simd_tbc_ks(benchmark::State& state) {
+  constexpr size_t N = 16;
+  constexpr size_t T = 3 * N;
+
+  uint8_t* txt = static_cast<uint8_t*>(std::malloc(N));
+  uint8_t* key = static_cast<uint8_t*>(std::malloc(T));
+
+  random_data(txt, N);
+  random_data(key, T);
+
+  skinny::state_t st;
+  skinny::key_schedule_t ks;
+
+  skinny::initialize(&st, txt, key);
+  skinny::expand_tk3(&ks, key + 2 * N);
+
+  for (auto _ : state) {
+    skinny_simd::tbc(&st, &ks);
+
+    benchmark::DoNotOptimize(st);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(N * state.iterations()));
+
+  std::free(txt);
+  std::free(key);
+}
+
+// Benchmarks Skinny-128-384+ tweakable block cipher on CPU, using
+// implementation picked by run time dispatcher, where tweakey state (2, 3) are
+// already expanded into combined round tweakeys
+static void skinny_simd_tbc_ts(benchmark::State& state) {
+  constexpr size_t N = 16;
+  constexpr size_t T = 3 * N;
+
+  uint8_t* txt = static_cast<uint8_t*>(std::malloc(N));
+  uint8_t* key = static_cast<uint8_t*>(std::malloc(T));
+
+  random_data(txt, N);
+  random_data(key, T);
+
+  skinny::state_t st;
+  skinny::key_schedule_t ks;
+  skinny::tweakey_schedule_t ts;
+
+  skinny::initialize(&st, txt, key);
+  skinny::expand_tk3(&ks, key + 2 * N);
+  skinny_rows::expand_tk2(&ts, key + N, &ks);
+
+  for (auto _ : state) {
+    skinny_simd::tbc(&st, &ts);
+
+    benchmark::DoNotOptimize(st);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(N * state.iterations()));
+
+  std::free(txt);
+  std::free(key);
+}
+
+// Benchmarks Skinny-128-384+ tweakable block cipher on CPU, encrypting two
+// independent states sharing round tweakeys of tweakey state (3), using
+// implementation picked by run time dispatcher
+static void skinny_simd_tbc_pair(benchmark::State& state) {
+  constexpr size_t N = 16;
+  constexpr size_t T = 3 * N;
+
+  uint8_t* txt = static_cast<uint8_t*>(std::malloc(N << 1));
+  uint8_t* key = static_cast<uint8_t*>(std::malloc(T << 1));
+
+  random_data(txt, N << 1);
+  random_data(key, T << 1);
+
+  skinny::state_t st0;
+  skinny::state_t st1;
+  skinny::key_schedule_t ks;
+
+  skinny::initialize(&st0, txt, key);
+  skinny::initialize(&st1, txt + N, key + T);
+  skinny::expand_tk3(&ks, key + 2 * N);
+
+  for (auto _ : state) {
+    skinny_simd::tbc_pair(&st0, &st1, &ks);
+
+    benchmark::DoNotOptimize(st0);
+    benchmark::DoNotOptimize(st1);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>((N << 1) * state.iterations()));
+
+  std::free(txt);
+  std::free(key);
+}
+
+// Benchmarks Skinny-128-384+ tweakable block cipher on CPU, encrypting two
+// blocks under same tweakey, using implementation picked by run time dispatcher
+static void skinny_simd_tbc2(benchmark::State& state) {
+  constexpr size_t N = 16;
+  constexpr size_t T = 3 * N;
+
+  uint8_t* txt = static_cast<uint8_t*>(std::malloc(N << 1));
+  uint8_t* key = static_cast<uint8_t*>(std::malloc(T));
+
+  random_data(txt, N << 1);
+  random_data(key, T);
+
+  skinny::state_t st;
+  skinny::initialize(&st, txt, key);
+
+  for (auto _ : state) {
+    skinny_simd::tbc2(&st, txt + N);
+
+    benchmark::DoNotOptimize(st);
+    benchmark::DoNotOptimize(txt);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>((N << 1) * state.iterations()));
+
+  std::free(txt);
+  std::free(key);
+}
+
+// Benchmarks Skinny-128-384+ tweakable block cipher on CPU, doing what two
+// independent `tbc2` calls do, in lockstep, using implementation picked by run
+// time dispatcher
+static void skinny_simd_tbc2x2(benchmark::State& state) {
+  constexpr size_t N = 16;
+  constexpr size_t T = 3 * N;
+
+  uint8_t* txt = static_cast<uint8_t*>(std::malloc(N << 2));
+  uint8_t* key = static_cast<uint8_t*>(std::malloc(T << 1));
+
+  random_data(txt, N << 2);
+  random_data(key, T << 1);
+
+  skinny::state_t st0;
+  skinny::state_t st1;
+  skinny::initialize(&st0, txt, key);
+  skinny::initialize(&st1, txt + (N << 1), key + T);
+
+  for (auto _ : state) {
+    skinny_simd::tbc2x2(&st0, txt + N, &st1, txt + 3 * N);
+
+    benchmark::DoNotOptimize(st0);
+    benchmark::DoNotOptimize(st1);
+    benchmark::DoNotOptimize(txt);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>((N << 2) * state.iterations()));
+
+  std::free(txt);
+  std::free(key);
+}
+
+// Benchmarks Skinny-128-384+ tweakable block cipher on CPU, encrypting same
+// block under two tweakeys, differing only in tweakey state (1), using
+// implementation picked by run time dispatcher
+static void skinny_simd_tbc2_tk1(benchmark::State& state) {
+  constexpr size_t N = 16;
+  constexpr size_t T = 3 * N;
+
+  uint8_t* txt = static_cast<uint8_t*>(std::malloc(N << 1));
+  uint8_t* key = static_cast<uint8_t*>(std::malloc(T + N));
+
+  random_data(txt, N << 1);
+  random_data(key, T + N);
+
+  skinny::state_t st;
+  skinny::initialize(&st, txt, key);
+
+  for (auto _ : state) {
+    skinny_simd::tbc2_tk1(&st, key + T, txt + N);
+
+    benchmark::DoNotOptimize(st);
+    benchmark::DoNotOptimize(txt);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>((N << 1) * state.iterations()));
+
+  std::free(txt);
+  std::free(key);
+}
+
+// Benchmarks bitsliced Skinny-128-384+ tweakable block cipher on CPU, which
+// processes LANES<T> -many independent blocks in a single call
+template<skinny_bitsliced::lane_word T>
+static void skinny_bitsliced_tbc(benchmark::State& state) {
+  constexpr size_t N = 16;
+  constexpr size_t L = skinny_bitsliced::LANES<T>;
+
+  skinny::state_t* sts =
+      static_cast<skinny::state_t*>(std::malloc(L * sizeof(skinny::state_t)));
+
+  for (size_t i = 0; i < L; i++) {
+    random_data(sts[i].arr, sizeof(sts[i].arr));
+  }
+
+  for (auto _ : state) {
+    skinny_bitsliced::tbc<T>(sts);
+
+    benchmark::DoNotOptimize(sts);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(L * N * state.iterations()));
+
+  std::free(sts);
+}
+
 }  // namespace bench_romulus
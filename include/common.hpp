@@ -36,6 +36,68 @@ inline static void update_lfsr(uint8_t* const lfsr) {
   lfsr[6] = (lfsr[6] << 1) ^ tmp;
 }
 
+// Packed form of 56 -bit LFSR, held in a 64 -bit word, such that i -th byte of
+// LFSR array ( as used by `set_lfsr` and `update_lfsr` ) is (6 - i) -th byte
+// of the word, which makes single step updation a shift and conditional XOR,
+// while LFSR value after N steps can be computed as x^N * value % F_56(x)
+constexpr uint64_t LFSR_MASK = (1ul << 56) - 1ul;
+
+// Packed form of initial value of 56 -bit LFSR, as set by `set_lfsr`
+constexpr uint64_t LFSR_INIT = 1ul << 48;
+
+// Single step updation of packed 56 -bit LFSR, equivalent to `update_lfsr`
+inline static constexpr uint64_t step_lfsr(const uint64_t v) {
+  const uint64_t z55 = v >> 55;
+  return ((v << 1) & LFSR_MASK) ^ (0x95ul & (0ul - z55));
+}
+
+// Multiplies two packed 56 -bit LFSR values, as polynomials over GF(2),
+// modulo F_56(x) = x^56 + x^7 + x^4 + x^2 + 1
+inline static constexpr uint64_t mul_lfsr(uint64_t a, const uint64_t b) {
+  uint64_t r = 0;
+
+  for (size_t i = 0; i < 56; i++) {
+    r ^= a & (0ul - ((b >> i) & 1ul));
+    a = step_lfsr(a);
+  }
+
+  return r;
+}
+
+// Precomputed x^(2^i) % F_56(x) | i = [0, 64), so that LFSR can be jumped ahead
+// by any 64 -bit step count, using at most 64 multiplications
+constexpr auto LFSR_POW = []() {
+  struct {
+    uint64_t arr[64];
+  } pow{};
+
+  pow.arr[0] = 0b10;
+  for (size_t i = 1; i < 64; i++) {
+    pow.arr[i] = mul_lfsr(pow.arr[i - 1], pow.arr[i - 1]);
+  }
+
+  return pow;
+}();
+
+// Computes value of packed 56 -bit LFSR after `n` single step updations of `v`,
+// in time independent of `n`, instead of applying `step_lfsr` n -many times
+inline static constexpr uint64_t jump_lfsr(uint64_t v, const uint64_t n) {
+  for (size_t i = 0; i < 64; i++) {
+    if ((n >> i) & 1ul) {
+      v = mul_lfsr(v, LFSR_POW.arr[i]);
+    }
+  }
+
+  return v;
+}
+
+// Unpacks packed 56 -bit LFSR into 7 -bytes array, as used by `encode`
+inline static void store_lfsr(const uint64_t v, uint8_t* const lfsr) {
+  for (size_t i = 0; i < 7; i++) {
+    lfsr[i] = static_cast<uint8_t>(v >> ((6 - i) << 3));
+  }
+}
+
 // Tweakey encoding for Romulus-{N, M, T}, which computes 384 -bit tweakey, to
 // be used as input to Skinny-128-384+ TBC
 //
@@ -55,6 +117,78 @@ inline static void encode(
   std::memcpy(tweakey + 32, key, 16);
 }
 
+// Same as above `encode`, except it only computes first 256 -bits of tweakey
+// i.e. tweakey state (1, 2), because tweakey state (3) i.e. secret key is
+// already expanded into round tweakeys, see skinny::expand_tk3
+inline static void encode(
+    const uint8_t* const __restrict tweak,    // 128 -bit twaek
+    const uint8_t* const __restrict counter,  // 56 -bit LFSR counter
+    const uint8_t d_sep,                      // 8 -bit domain seperator
+    uint8_t* const __restrict tweakey         // 256 -bit tweakey ( computed )
+) {
+  std::memcpy(tweakey, counter, 7);
+  std::memcpy(tweakey + 7, &d_sep, 1);
+  std::memset(tweakey + 8, 0, 8);
+  std::memcpy(tweakey + 16, tweak, 16);
+}
+
+// Same as above `encode` routines, except LFSR counter is in packed form, see
+// `step_lfsr`
+inline static void encode(
+    const uint8_t* const __restrict key,    // 128 -bit key
+    const uint8_t* const __restrict tweak,  // 128 -bit twaek
+    const uint64_t counter,                 // packed 56 -bit LFSR counter
+    const uint8_t d_sep,                    // 8 -bit domain seperator
+    uint8_t* const __restrict tweakey       // 384 -bit tweakey ( computed )
+) {
+  store_lfsr(counter, tweakey);
+  tweakey[7] = d_sep;
+  std::memset(tweakey + 8, 0, 8);
+  std::memcpy(tweakey + 16, tweak, 16);
+  std::memcpy(tweakey + 32, key, 16);
+}
+
+// Same as above `encode`, except it only computes first 256 -bits of tweakey
+// i.e. tweakey state (1, 2), from packed LFSR counter, because secret key is
+// already expanded into round tweakeys, see skinny::expand_tk3
+inline static void encode(
+    const uint8_t* const __restrict tweak,  // 128 -bit twaek
+    const uint64_t counter,                 // packed 56 -bit LFSR counter
+    const uint8_t d_sep,                    // 8 -bit domain seperator
+    uint8_t* const __restrict tweakey       // 256 -bit tweakey ( computed )
+) {
+  store_lfsr(counter, tweakey);
+  tweakey[7] = d_sep;
+  std::memset(tweakey + 8, 0, 8);
+  std::memcpy(tweakey + 16, tweak, 16);
+}
+
+// Same as above `encode` routines, except it only computes first 128 -bits of
+// tweakey i.e. tweakey state (1), because tweakey state (2, 3) i.e. nonce and
+// secret key are already expanded into round tweakeys, see skinny::expand_tk2
+inline static void encode(
+    const uint8_t* const __restrict counter,  // 56 -bit LFSR counter
+    const uint8_t d_sep,                      // 8 -bit domain seperator
+    uint8_t* const __restrict tweakey         // 128 -bit tweakey ( computed )
+) {
+  std::memcpy(tweakey, counter, 7);
+  std::memcpy(tweakey + 7, &d_sep, 1);
+  std::memset(tweakey + 8, 0, 8);
+}
+
+// Same as above `encode`, except LFSR counter is in packed form, see
+// `step_lfsr`, computing only tweakey state (1), because nonce and secret key
+// are already expanded into round tweakeys, see skinny::expand_tk2
+inline static void encode(
+    const uint64_t counter,            // packed 56 -bit LFSR counter
+    const uint8_t d_sep,               // 8 -bit domain seperator
+    uint8_t* const __restrict tweakey  // 128 -bit tweakey ( computed )
+) {
+  store_lfsr(counter, tweakey);
+  tweakey[7] = d_sep;
+  std::memset(tweakey + 8, 0, 8);
+}
+
 // State update function for Romulus-{N, M}, as defined in section 2.4.2 of
 // Romulus specification
 // https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/romulus-spec-final.pdf
@@ -107,4 +241,97 @@ inline static void rho_inv(
   }
 }
 
+// Padding rule, applied on end of each input, walked by `blocks_t`
+enum class pad_t {
+  // Empty input contributes a single all zero block, otherwise only a partial
+  // last block is padded, as Romulus-M does
+  romulusm,
+  // Empty input contributes no block, otherwise input always ends with a padded
+  // block, which carries no bytes, when input length is multiple of 16, as
+  // Romulus-T does
+  romulust
+};
+
+// Forward iterator over 16 -bytes blocks of padded associated data, followed by
+// padded text, as authenticated by Romulus-{M, T}. Full blocks are handed out
+// as pointers into caller's buffers, while only padded last block of each input
+// is materialized into `buf`, by zero padding it and setting its last byte to #
+// -of bytes it carries.
+struct blocks_t {
+  const uint8_t* seg[2];  // associated data, text
+  size_t len[2];          // len(seg[i]) | >= 0
+  size_t idx;             // index of input being walked
+  size_t off;             // byte offset of next block in seg[idx]
+  pad_t pad;              // padding rule
+  uint8_t buf[16];        // materialized padded block
+};
+
+// Prepares iterator for walking N -bytes associated data, followed by M -bytes
+// text | N, M >= 0, where end of each input is padded following `pad` rule
+inline static void init_blocks(blocks_t* const __restrict it,
+                               const uint8_t* const __restrict data,
+                               const size_t dlen,
+                               const uint8_t* const __restrict text,
+                               const size_t ctlen,
+                               const pad_t pad) {
+  it->seg[0] = data;
+  it->seg[1] = text;
+  it->len[0] = dlen;
+  it->len[1] = ctlen;
+  it->idx = 0;
+  it->off = 0;
+  it->pad = pad;
+}
+
+// Returns # -of full blocks, which are available contiguously, starting at
+// current position of iterator, see `take_blocks`
+inline static size_t full_blocks(const blocks_t* const __restrict it) {
+  if (it->idx > 1) {
+    return 0;
+  }
+  return (it->len[it->idx] - it->off) >> 4;
+}
+
+// Returns pointer to `cnt` -many contiguous full blocks, in caller's buffer,
+// advancing iterator past them | cnt <= full_blocks(it)
+inline static const uint8_t* take_blocks(blocks_t* const __restrict it,
+                                         const size_t cnt) {
+  const uint8_t* const ptr = it->seg[it->idx] + it->off;
+  it->off += cnt << 4;
+  return ptr;
+}
+
+// Returns pointer to next 16 -bytes block, which is either in caller's buffer
+// or, for padded block, in `buf` ( valid until next call ), advancing iterator
+// past it. Returns null, when both inputs are exhausted.
+inline static const uint8_t* next_block(blocks_t* const __restrict it) {
+  while (it->idx < 2) {
+    const size_t len = it->len[it->idx];
+    const size_t rm = len - it->off;
+
+    if (rm >= 16) {
+      return take_blocks(it, 1);
+    }
+
+    const bool pad = it->pad == pad_t::romulusm ? (rm > 0) | (len == 0)
+                                                : (len > 0);
+    const uint8_t* const src = it->seg[it->idx] + it->off;
+
+    it->idx++;
+    it->off = 0;
+
+    if (pad) {
+      std::memset(it->buf, 0, 16);
+      if (rm > 0) {
+        std::memcpy(it->buf, src, rm);
+      }
+      it->buf[15] = static_cast<uint8_t>(rm);
+
+      return it->buf;
+    }
+  }
+
+  return nullptr;
+}
+
 }  // namespace romulus_common
@@ -1,5 +1,9 @@
 #pragma once
+#include <algorithm>
+
 #include "skinny.hpp"
+#include "skinny_bitsliced.hpp"
+#include "skinny_simd.hpp"
 
 // Romulus Hash Function
 namespace romulush {
@@ -16,31 +20,26 @@ inline static void compress(
     const uint8_t* const __restrict msg  // 32 -bytes message to be compressed
 ) {
   skinny::state_t st;
-  uint8_t left_prime[16];
+  uint8_t left_flipped[16];
 
   std::memcpy(st.arr + 0, left, 16);
   std::memcpy(st.arr + 16, right, 16);
   std::memcpy(st.arr + 32, msg, 32);
 
-  skinny::tbc(&st);
+  std::memcpy(left_flipped, left, 16);
+  left_flipped[0] ^= 0b00000001;
+
+  // both TBC calls use same tweakey i.e. right || msg
+  std::memcpy(right, left_flipped, 16);
+  skinny_simd::tbc2(&st, right);
 
   for (size_t i = 0; i < 16; i++) {
-    left_prime[i] = st.arr[i] ^ left[i];
+    right[i] ^= left_flipped[i];
   }
 
-  left[0] ^= 0b00000001;
-
-  std::memcpy(st.arr + 0, left, 16);
-  std::memcpy(st.arr + 16, right, 16);
-  std::memcpy(st.arr + 32, msg, 32);
-
-  skinny::tbc(&st);
-
   for (size_t i = 0; i < 16; i++) {
-    right[i] = st.arr[i] ^ left[i];
+    left[i] ^= st.arr[i];
   }
-
-  std::memcpy(left, left_prime, 16);
 }
 
 // Given N -bytes input message this routine computes 32 -bytes digest using
@@ -82,4 +81,242 @@ inline static void hash(
   std::memcpy(dig + 16, right, 16);
 }
 
+// Incremental Romulus-H hasher state, which allows message to be absorbed in
+// arbitrary sized chunks, using constant memory, computing same digest as
+// one-shot `hash` routine
+//
+// Expected call sequence is `init` -> `absorb`* -> `finalize`.
+struct hasher_t {
+  uint8_t left[16];   // 16 -bytes chaining state
+  uint8_t right[16];  // 16 -bytes chaining state
+  uint8_t buf[32];    // message bytes, not yet compressed
+  size_t blen;        // number of bytes in `buf` | < 32
+};
+
+// Prepares incremental Romulus-H hasher state for hashing a new message
+inline static void init(hasher_t* const __restrict hasher) {
+  std::memset(hasher->left, 0, sizeof(hasher->left));
+  std::memset(hasher->right, 0, sizeof(hasher->right));
+  hasher->blen = 0;
+}
+
+// Prepares incremental Romulus-H hasher state for hashing a new message, which
+// continues from 32 -bytes chaining state `iv` ( i.e. left || right ), reached
+// after compressing some prefix of full blocks, instead of from all zero state
+inline static void init(hasher_t* const __restrict hasher,
+                        const uint8_t* const __restrict iv) {
+  std::memcpy(hasher->left, iv, 16);
+  std::memcpy(hasher->right, iv + 16, 16);
+  hasher->blen = 0;
+}
+
+// Absorbs N -bytes message into incremental Romulus-H hasher state | N >= 0,
+// which can be called any number of times, before finalizing it.
+//
+// Note, a full 32 -bytes block can be compressed as soon as it's available,
+// because one-shot `hash` routine always finishes with a padded block, which
+// is empty, when message length is a multiple of 32.
+inline static void absorb(
+    hasher_t* const __restrict hasher,    // Romulus-H hasher
+    const uint8_t* const __restrict msg,  // N -bytes message
+    const size_t mlen                     // len(msg) | >= 0
+) {
+  size_t off = 0;
+
+  if (hasher->blen > 0) {
+    const size_t to_read = std::min(32ul - hasher->blen, mlen);
+
+    std::memcpy(hasher->buf + hasher->blen, msg, to_read);
+    hasher->blen += to_read;
+    off += to_read;
+
+    if (hasher->blen < 32) {
+      return;
+    }
+
+    compress(hasher->left, hasher->right, hasher->buf);
+    hasher->blen = 0;
+  }
+
+  while (mlen - off >= 32) {
+    compress(hasher->left, hasher->right, msg + off);
+    off += 32;
+  }
+
+  std::memcpy(hasher->buf, msg + off, mlen - off);
+  hasher->blen = mlen - off;
+}
+
+// Finishes absorption of message into incremental Romulus-H hasher state, by
+// compressing padded last block, with domain separation, computing 32 -bytes
+// digest. Hasher must be initialized again, before being used for another
+// message.
+inline static void finalize(
+    hasher_t* const __restrict hasher,  // Romulus-H hasher
+    uint8_t* const __restrict dig       // 32 -bytes digest computed
+) {
+  uint8_t last_blk[32];
+  std::memset(last_blk, 0, sizeof(last_blk));
+
+  std::memcpy(last_blk, hasher->buf, hasher->blen);
+  last_blk[31] = static_cast<uint8_t>(hasher->blen);
+
+  hasher->left[0] ^= 0b00000010;
+
+  compress(hasher->left, hasher->right, last_blk);
+
+  std::memcpy(dig, hasher->left, 16);
+  std::memcpy(dig + 16, hasher->right, 16);
+}
+
+// Number of messages hashed in lockstep by `hash_many`, such that two TBC calls
+// of each message's compression function fill all lanes of widest bitsliced
+// Skinny-128-384+ routine
+constexpr size_t MANY_LANES = skinny_bitsliced::LANES<uint64_t> >> 1;
+
+// Given N -many independent messages | N >= 0, this routine computes 32 -bytes
+// Romulus-H digest of each of them, producing same digests as calling `hash`
+// on each of them.
+//
+// Upto `MANY_LANES` -many messages are hashed in lockstep, where both TBC calls
+// of compression function of all of them are batched together and handed over
+// to multi-block Skinny-128-384+ routine. As soon as a message is completely
+// absorbed, its lane is refilled with next message, so that lanes are kept
+// busy, even when message lengths vary widely.
+//
+// When CPU supports AVX2 or AVX-512, vectorized Skinny-128-384+ is faster
+// than bitsliced one, so compression functions of two lanes are instead
+// computed together, using `skinny_simd::tbc2x2`, overlapping their otherwise
+// serial dependency chains.
+//
+// When `iv` is non-null, hashing of each message continues from 32 -bytes
+// chaining state `iv` ( i.e. left || right ), instead of from all zero state,
+// see `init` routine of incremental hasher.
+inline static void hash_many(
+    const uint8_t* const* const __restrict msgs,  // N -many input messages
+    const size_t* const __restrict mlens,         // length of each message
+    uint8_t* const* const __restrict digs,        // N -many 32 -bytes digests
+    const size_t n,                               // number of messages | >= 0
+    const uint8_t* const __restrict iv = nullptr  // 32 -bytes state or null
+) {
+  constexpr uint8_t zeros[32]{};
+  const uint8_t* const iv_ = iv == nullptr ? zeros : iv;
+
+  struct lane_t {
+    uint8_t left[16];
+    uint8_t right[16];
+    uint8_t last_blk[32];
+    size_t idx;      // index of message being hashed in this lane
+    size_t blk;      // index of block to be compressed next
+    size_t blk_cnt;  // number of full 32 -bytes blocks in message
+  };
+
+  lane_t lanes[MANY_LANES];
+  skinny::state_t sts[MANY_LANES << 1];
+
+  const bool simd = skinny_simd::isa() != skinny_simd::isa_t::portable;
+
+  size_t active = 0;
+  size_t next = 0;
+
+  while (true) {
+    // refill free lanes with messages, yet to be hashed
+    while ((active < MANY_LANES) & (next < n)) {
+      lane_t* const l = lanes + active;
+
+      std::memcpy(l->left, iv_, 16);
+      std::memcpy(l->right, iv_ + 16, 16);
+
+      l->idx = next;
+      l->blk = 0;
+      l->blk_cnt = mlens[next] >> 5;
+
+      active++;
+      next++;
+    }
+
+    if (active == 0) {
+      break;
+    }
+
+    for (size_t i = 0; i < active; i++) {
+      lane_t* const l = lanes + i;
+      const uint8_t* blk = msgs[l->idx] + (l->blk << 5);
+
+      if (l->blk == l->blk_cnt) {
+        const size_t rm_bytes = mlens[l->idx] & 31;
+
+        std::memset(l->last_blk, 0, sizeof(l->last_blk));
+        std::memcpy(l->last_blk, blk, rm_bytes);
+        l->last_blk[31] = static_cast<uint8_t>(rm_bytes);
+
+        l->left[0] ^= 0b00000010;
+        blk = l->last_blk;
+      }
+
+      skinny::state_t* const st0 = sts + (i << 1);
+      skinny::state_t* const st1 = st0 + 1;
+
+      std::memcpy(st0->arr + 0, l->left, 16);
+      std::memcpy(st0->arr + 16, l->right, 16);
+      std::memcpy(st0->arr + 32, blk, 32);
+
+      std::memcpy(st1->arr, st0->arr, sizeof(st0->arr));
+      st1->arr[0] ^= 0b00000001;
+    }
+
+    if (simd) {
+      // second state of each lane only carries block, encrypted under tweakey
+      // of first one
+      size_t i = 0;
+      for (; i + 1 < active; i += 2) {
+        skinny::state_t* const st0 = sts + (i << 1);
+        skinny::state_t* const st1 = st0 + 2;
+
+        skinny_simd::tbc2x2(st0, st0[1].arr, st1, st1[1].arr);
+      }
+      if (i < active) {
+        skinny::state_t* const st0 = sts + (i << 1);
+        skinny_simd::tbc2(st0, st0[1].arr);
+      }
+    } else {
+      skinny_bitsliced::tbc_many(sts, active << 1);
+    }
+
+    size_t i = 0;
+    while (i < active) {
+      lane_t* const l = lanes + i;
+
+      const skinny::state_t* const st0 = sts + (i << 1);
+      const skinny::state_t* const st1 = st0 + 1;
+
+      for (size_t j = 0; j < 16; j++) {
+        l->right[j] = st1->arr[j] ^ l->left[j];
+      }
+      l->right[0] ^= 0b00000001;
+
+      for (size_t j = 0; j < 16; j++) {
+        l->left[j] ^= st0->arr[j];
+      }
+
+      if (l->blk < l->blk_cnt) {
+        l->blk++;
+        i++;
+        continue;
+      }
+
+      std::memcpy(digs[l->idx], l->left, 16);
+      std::memcpy(digs[l->idx] + 16, l->right, 16);
+
+      // move last active lane into this one, keeping active lanes contiguous
+      active--;
+      if (i < active) {
+        std::memcpy(lanes + i, lanes + active, sizeof(lane_t));
+        std::memcpy(sts + (i << 1), sts + (active << 1),
+                    sizeof(skinny::state_t) << 1);
+      }
+    }
+  }
+}
+
 }  // namespace romulush
@@ -3,150 +3,198 @@
 
 #include "common.hpp"
 #include "skinny.hpp"
+#include "skinny_simd.hpp"
 
 // Romulus-M Authenticated Encryption with Associated Data
 namespace romulusm {
 
-// Extract N-th message block ( 128 -bit wide ) from concatenated padded
-// associated data bytes and padded plain text bytes. Last block of both
-// associated data and plain text can be padded, if required.
-static void get_auth_block(
-    const uint8_t* const __restrict data,  // N -bytes associated data
-    const size_t dlen,                     // len(data) = N | >= 0
-    const uint8_t* const __restrict text,  // M -bytes plain text
-    const size_t ctlen,                    // len(text) = M | >= 0
-    const size_t blk_idx,                  // Index of block to extract
-    uint8_t* const __restrict blk          // 16 -bytes extracted (padded) block
+// Associated data absorbed into MAC chain of Romulus-M, which depends only on
+// secret key and associated data, but not on nonce or plain text, so that
+// associated data repeated across many messages ( say a fixed protocol header )
+// can be absorbed only once, see `absorb`, and each message starts from it, see
+// `encrypt`/ `decrypt` routines taking it
+struct ad_snapshot_t {
+  uint8_t st[16];   // MAC chain state, after absorbing all pairs of AD blocks
+  uint8_t blk[16];  // last ( padded ) AD block, yet to be absorbed, when `odd`
+  uint64_t lfsr;    // packed 56 -bit LFSR counter
+  bool odd;         // # -of ( padded ) associated data blocks is odd
+  uint8_t d_sep;    // domain seperator of last MAC call, as set by AD
+};
+
+// Given expanded secret key and N -bytes associated data | N >= 0, this
+// routine absorbs all pairs of ( padded ) associated data blocks into MAC
+// chain, leaving last block pending, when # -of blocks is odd, because it's
+// paired with first plain text block, computing a snapshot, which can be used
+// for encrypting/ decrypting any number of messages, under any nonce
+inline static void absorb(
+    ad_snapshot_t* const __restrict snap,  // absorbed AD ( computed )
+    const skinny::key_schedule_t* const __restrict ks,  // expanded secret key
+    const uint8_t* const __restrict data,               // N -bytes AD
+    const size_t dlen                                   // len(data) = N | >= 0
 ) {
-  std::memset(blk, 0, 16);
+  skinny::state_t st;
 
-  const size_t tmp0 = dlen & 15ul;
-  const size_t tmp1 = ctlen & 15ul;
+  uint64_t lfsr = romulus_common::LFSR_INIT;
+  uint8_t enc[16];
+
+  std::memset(st.arr, 0, 16);
 
-  const bool flg0 = (dlen == 0) | (tmp0 > 0ul);
-  const bool flg1 = (ctlen == 0) | (tmp1 > 0ul);
+  const size_t ad_blk_cnt = dlen >> 4;
+  const size_t ad_rm_bytes = dlen & 15ul;
 
-  const size_t off = blk_idx << 4;
+  const bool flg0 = (dlen == 0) | (ad_rm_bytes > 0);
 
-  const size_t padded_dlen = dlen + (16ul - tmp0) * flg0;
-  const size_t padded_ctlen = ctlen + (16ul - tmp1) * flg1;
+  const size_t tot_ad_blk_cnt = ad_blk_cnt + 1ul * flg0;
+  const size_t half_ad_blk_cnt = tot_ad_blk_cnt >> 1;
 
-  const size_t padded_authlen = padded_dlen + padded_ctlen;
+  romulus_common::blocks_t it;
+  romulus_common::init_blocks(&it, data, dlen, nullptr, 0ul,
+                              romulus_common::pad_t::romulusm);
 
-  if (off < padded_dlen) {
-    const size_t read = std::min(16ul, dlen - off);
+  for (size_t i = 0; i < half_ad_blk_cnt; i++) {
+    romulus_common::rho(st.arr, romulus_common::next_block(&it), enc);
+    lfsr = romulus_common::step_lfsr(lfsr);
 
-    std::memcpy(blk, data + off, read);
+    const uint8_t* const blk = romulus_common::next_block(&it);
+    romulus_common::encode(blk, lfsr, 40, st.arr + 16);
 
-    const uint8_t br[]{blk[15], static_cast<uint8_t>(read)};
-    blk[15] = br[read < 16ul];
+    skinny_simd::tbc(&st, ks);
+    lfsr = romulus_common::step_lfsr(lfsr);
   }
 
-  if ((off >= padded_dlen) && (off < padded_authlen)) {
-    const size_t ctoff = off - padded_dlen;
-    const size_t read = std::min(16ul, ctlen - ctoff);
+  snap->odd = static_cast<bool>(tot_ad_blk_cnt & 1ul);
+  if (snap->odd) {
+    std::memcpy(snap->blk, romulus_common::next_block(&it), 16);
+  }
+
+  std::memcpy(snap->st, st.arr, 16);
+  snap->lfsr = lfsr;
+
+  uint8_t w = 48;
+
+  w ^= 2 * flg0;
+  w ^= 8 * (1 - (tot_ad_blk_cnt & 1));
 
-    std::memcpy(blk, text + ctoff, read);
+  snap->d_sep = w;
+}
 
-    const uint8_t br[]{blk[15], static_cast<uint8_t>(read)};
-    blk[15] = br[read < 16ul];
+// Given 16 -bytes secret key and N -bytes associated data | N >= 0, this
+// routine computes snapshot of associated data absorbed into MAC chain, see
+// above
+inline static void absorb(
+    ad_snapshot_t* const __restrict snap,  // absorbed AD ( computed )
+    const uint8_t* const __restrict key,   // 128 -bit secret key
+    const uint8_t* const __restrict data,  // N -bytes associated data
+    const size_t dlen                      // len(data) = N | >= 0
+) {
+  skinny::key_schedule_t ks;
+  skinny::expand_tk3(&ks, key);
+
+  absorb(snap, &ks, data, dlen);
+}
+
+// Prepares iterator for walking blocks, which are still to be absorbed into MAC
+// chain, after associated data snapshot is taken i.e. pending associated data
+// block ( if any ), followed by M -bytes text | M >= 0
+inline static void init_blocks(romulus_common::blocks_t* const __restrict it,
+                               const ad_snapshot_t* const __restrict snap,
+                               const uint8_t* const __restrict text,
+                               const size_t ctlen) {
+  constexpr auto pad = romulus_common::pad_t::romulusm;
+
+  if (snap->odd) {
+    romulus_common::init_blocks(it, snap->blk, 16ul, text, ctlen, pad);
+  } else {
+    romulus_common::init_blocks(it, text, ctlen, nullptr, 0ul, pad);
   }
 }
 
-// Given 16 -bytes secret key, 16 -bytes nonce, N -bytes associated data and M
-// -bytes plain text | N, M >= 0, this routine computes M -bytes encrypted text
-// and 16 -bytes authentication tag, using Romulus-M authenticated encryption
-// algorithm, which is nonce misuse-resistant.
+// Given expanded secret key ( see skinny::expand_tk3 ), already absorbed
+// associated data ( see `absorb` ), 16 -bytes nonce and M -bytes plain text | M
+// >= 0, this routine computes M -bytes encrypted text and 16 -bytes
+// authentication tag, using Romulus-M authenticated encryption algorithm. When
+// encrypting many messages under same key, expand it only once.
 //
 // See encryption algorithm defined in figure 2.7 of Romulus specification
 // https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/romulus-spec-final.pdf
-static void encrypt(
-    const uint8_t* const __restrict key,    // 128 -bit secret key
-    const uint8_t* const __restrict nonce,  // 128 -bit public message nonce
-    const uint8_t* const __restrict data,   // N -bytes associated data
-    const size_t dlen,                      // len(data) = N | >= 0
-    const uint8_t* const __restrict text,   // M -bytes plain text
-    uint8_t* const __restrict cipher,       // M -bytes encrypted text
-    const size_t ctlen,                     // len(text) = len(cipher) | >= 0
-    uint8_t* const __restrict tag           // 128 -bit authentication tag
+inline static void encrypt(
+    const skinny::key_schedule_t* const __restrict ks,  // expanded secret key
+    const ad_snapshot_t* const __restrict snap,  // absorbed associated data
+    const uint8_t* const __restrict nonce,       // 128 -bit message nonce
+    const uint8_t* const __restrict text,        // M -bytes plain text
+    uint8_t* const __restrict cipher,            // M -bytes encrypted text
+    const size_t ctlen,                          // len(text) = len(cipher)
+    uint8_t* const __restrict tag                // 128 -bit authentication tag
 ) {
   skinny::state_t st;
+  skinny::tweakey_schedule_t ts;
 
-  uint8_t lfsr[7];
+  uint64_t lfsr = snap->lfsr;
   uint8_t enc[16];
 
-  std::memset(st.arr, 0, 16);
-  romulus_common::set_lfsr(lfsr);
+  std::memcpy(st.arr, snap->st, 16);
+
+  // nonce and secret key are tweakey state (2, 3) of last TBC call of MAC
+  // chain and of all TBC calls of encryption chain, so their round tweakeys
+  // are combined only once and each of those calls only encodes tweakey state
+  // (1)
+  skinny_rows::expand_tk2(&ts, nonce, ks);
 
   {
-    const size_t ad_blk_cnt = dlen >> 4;
     const size_t ct_blk_cnt = ctlen >> 4;
-
-    const size_t ad_rm_bytes = dlen & 15ul;
     const size_t ct_rm_bytes = ctlen & 15ul;
 
-    const bool flg0 = (dlen == 0) | (ad_rm_bytes > 0);
     const bool flg1 = (ctlen == 0) | (ct_rm_bytes > 0);
 
-    const size_t tot_ad_blk_cnt = ad_blk_cnt + 1ul * flg0;
     const size_t tot_ct_blk_cnt = ct_blk_cnt + 1ul * flg1;
 
-    uint8_t w = 48;
+    uint8_t w = snap->d_sep;
 
-    w ^= 2 * flg0;
     w ^= 1 * flg1;
-    w ^= 8 * (1 - (tot_ad_blk_cnt & 1));
     w ^= 4 * (1 - (tot_ct_blk_cnt & 1));
 
-    const size_t tot_blk_cnt = tot_ad_blk_cnt + tot_ct_blk_cnt;
+    // remaining blocks of MAC chain, where all pairs use domain seperator 44
+    const size_t tot_blk_cnt = 1ul * snap->odd + tot_ct_blk_cnt;
     const size_t half_blk_cnt = tot_blk_cnt >> 1;
-    const size_t half_ad_blk_cnt = tot_ad_blk_cnt >> 1;
 
-    uint8_t blk[16]{};
-    uint8_t x = 40;
+    romulus_common::blocks_t it;
+    init_blocks(&it, snap, text, ctlen);
 
     for (size_t i = 0; i < half_blk_cnt; i++) {
-      get_auth_block(data, dlen, text, ctlen, (i << 1) ^ 0ul, blk);
+      romulus_common::rho(st.arr, romulus_common::next_block(&it), enc);
+      lfsr = romulus_common::step_lfsr(lfsr);
 
-      romulus_common::rho(st.arr, blk, enc);
-      romulus_common::update_lfsr(lfsr);
+      const uint8_t* const blk = romulus_common::next_block(&it);
+      romulus_common::encode(blk, lfsr, 44, st.arr + 16);
 
-      x ^= 4 * (i == half_ad_blk_cnt);
-
-      get_auth_block(data, dlen, text, ctlen, (i << 1) ^ 1ul, blk);
-      romulus_common::encode(key, blk, lfsr, x, st.arr + 16);
-
-      skinny::tbc(&st);
-      romulus_common::update_lfsr(lfsr);
+      skinny_simd::tbc(&st, ks);
+      lfsr = romulus_common::step_lfsr(lfsr);
     }
 
-    const bool flg2 = static_cast<bool>(tot_ad_blk_cnt & 1ul);
+    const bool flg2 = snap->odd;
     const bool flg3 = static_cast<bool>(tot_ct_blk_cnt & 1ul);
 
-    if (flg2 == flg3) {
-      std::memset(blk, 0, 16);
-    } else {
-      get_auth_block(data, dlen, text, ctlen, tot_blk_cnt - 1, blk);
-    }
+    constexpr uint8_t zeros[16]{};
+    const uint8_t* const blk =
+        flg2 == flg3 ? zeros : romulus_common::next_block(&it);
 
     romulus_common::rho(st.arr, blk, enc);
 
     if (tot_blk_cnt > (half_blk_cnt << 1)) {
-      romulus_common::update_lfsr(lfsr);
+      lfsr = romulus_common::step_lfsr(lfsr);
     }
 
-    romulus_common::encode(key, nonce, lfsr, w, st.arr + 16);
+    romulus_common::encode(lfsr, w, st.arr + 16);
 
-    skinny::tbc(&st);
+    skinny_simd::tbc(&st, &ts);
   }
 
   uint8_t tmp[16]{};
-  std::memset(tmp, 0, 16);
 
   romulus_common::rho(st.arr, tmp, tag);
 
   if (ctlen > 0ul) {
-    romulus_common::set_lfsr(lfsr);
+    lfsr = romulus_common::LFSR_INIT;
 
     std::memcpy(st.arr, tag, 16);
 
@@ -156,174 +204,229 @@ static void encrypt(
     const bool flg = (ctlen == 0) | (rm_bytes > 0);
     const size_t tot_blk_cnt = blk_cnt + 1ul * flg;
 
+    romulus_common::blocks_t it;
+    romulus_common::init_blocks(&it, text, ctlen, nullptr, 0ul,
+                                romulus_common::pad_t::romulusm);
+
     size_t off = 0ul;
 
     for (size_t i = 0; i < tot_blk_cnt - 1; i++) {
-      romulus_common::encode(key, nonce, lfsr, 36, st.arr + 16);
+      romulus_common::encode(lfsr, 36, st.arr + 16);
 
-      skinny::tbc(&st);
+      skinny_simd::tbc(&st, &ts);
 
-      romulus_common::rho(st.arr, text + off, cipher + off);
-      romulus_common::update_lfsr(lfsr);
+      romulus_common::rho(st.arr, romulus_common::next_block(&it),
+                          cipher + off);
+      lfsr = romulus_common::step_lfsr(lfsr);
 
       off += 16;
     }
 
     const size_t read = ctlen - off;
 
-    uint8_t blk[16]{};
+    romulus_common::encode(lfsr, 36, st.arr + 16);
 
-    std::memset(blk, 0, 16);
-    std::memcpy(blk, text + off, read);
+    skinny_simd::tbc(&st, &ts);
 
-    const uint8_t br[]{blk[15], static_cast<uint8_t>(read)};
-    blk[15] = br[read < 16ul];
+    romulus_common::rho(st.arr, romulus_common::next_block(&it), enc);
+    std::memcpy(cipher + off, enc, read);
+  }
+}
 
-    romulus_common::encode(key, nonce, lfsr, 36, st.arr + 16);
+// Given 16 -bytes secret key, 16 -bytes nonce, N -bytes associated data and M
+// -bytes plain text | N, M >= 0, this routine computes M -bytes encrypted text
+// and 16 -bytes authentication tag, using Romulus-M authenticated encryption
+// algorithm, which is nonce misuse-resistant.
+//
+// See encryption algorithm defined in figure 2.7 of Romulus specification
+// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/romulus-spec-final.pdf
+static void encrypt(
+    const uint8_t* const __restrict key,    // 128 -bit secret key
+    const uint8_t* const __restrict nonce,  // 128 -bit public message nonce
+    const uint8_t* const __restrict data,   // N -bytes associated data
+    const size_t dlen,                      // len(data) = N | >= 0
+    const uint8_t* const __restrict text,   // M -bytes plain text
+    uint8_t* const __restrict cipher,       // M -bytes encrypted text
+    const size_t ctlen,                     // len(text) = len(cipher) | >= 0
+    uint8_t* const __restrict tag           // 128 -bit authentication tag
+) {
+  skinny::key_schedule_t ks;
+  skinny::expand_tk3(&ks, key);
 
-    skinny::tbc(&st);
+  ad_snapshot_t snap;
+  absorb(&snap, &ks, data, dlen);
 
-    romulus_common::rho(st.arr, blk, enc);
-    std::memcpy(cipher + off, enc, read);
-  }
+  encrypt(&ks, &snap, nonce, text, cipher, ctlen, tag);
 }
 
-// Given 16 -bytes secret key, 16 -bytes nonce, 16 -bytes authentication tag, N
-// -bytes associated data and M -bytes encrypted text | N, M >= 0, this routine
-// computes M -bytes decrypted text and boolean verification flag, using
-// Romulus-M verified decryption algorithm, which is nonce misuse-resistant.
+// Decryption chain is allowed to run ahead of MAC chain by at most these many
+// bytes of decrypted text, so that decrypted text blocks are absorbed into MAC
+// chain while they are still in cache, even when associated data is long
+constexpr size_t FUSE_WINDOW = 1ul << 18;
+
+// Given expanded secret key, 16 -bytes nonce, 16 -bytes authentication tag, MAC
+// chain state to start from ( see `ad_snapshot_t` ), iterator walking
+// `tot_ad_blk_cnt` -many ( padded ) associated data blocks, which are yet to be
+// absorbed into MAC chain, followed by decrypted text, and M -bytes encrypted
+// text | M >= 0, this routine computes M -bytes decrypted text and boolean
+// verification flag, using Romulus-M verified decryption algorithm. Only `st`,
+// `lfsr` and `d_sep` of MAC chain snapshot are used.
+//
+// Decryption chain ( keyed by authentication tag ) doesn't depend on MAC chain,
+// while MAC chain depends on decrypted text only after associated data blocks
+// are absorbed. So both chains are advanced in lockstep, one TBC call of each
+// per step, using skinny_simd::tbc_pair, such that associated data is
+// authenticated while cipher text is being decrypted and MAC chain continues
+// over decrypted text blocks, as soon as they are produced. Decrypted text is
+// thus traversed once, while MAC chain trails decryption chain by no more than
+// `window` -bytes, which is FUSE_WINDOW, unless a wider one is asked for ( say
+// whole text, for comparing against decrypting it before authenticating it, in
+// a second pass ). Decrypted text is written through `text` and read back
+// through `it`, so `text` isn't `__restrict` qualified.
 //
 // See decryption algorithm defined in figure 2.7 of Romulus specification
 // https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/romulus-spec-final.pdf
-static bool decrypt(
-    const uint8_t* const __restrict key,     // 128 -bit secret key
-    const uint8_t* const __restrict nonce,   // 128 -bit public message nonce
-    const uint8_t* const __restrict tag,     // 128 -bit authentication tag
-    const uint8_t* const __restrict data,    // N -bytes associated data
-    const size_t dlen,                       // len(data) = N | >= 0
+inline static bool decrypt(
+    const skinny::key_schedule_t* const __restrict ks,  // expanded secret key
+    const uint8_t* const __restrict nonce,       // 128 -bit message nonce
+    const uint8_t* const __restrict tag,         // 128 -bit authentication tag
+    const ad_snapshot_t* const __restrict snap,  // MAC chain to start from
+    romulus_common::blocks_t* const __restrict it,  // blocks to be absorbed
+    const size_t tot_ad_blk_cnt,             // # -of AD blocks walked by `it`
     const uint8_t* const __restrict cipher,  // M -bytes encrypted text
-    uint8_t* const __restrict text,          // M -bytes decrypted text
-    const size_t ctlen                       // len(text) = len(cipher) | >= 0
+    uint8_t* const text,                     // M -bytes decrypted text
+    const size_t ctlen,                      // len(text) = len(cipher) | >= 0
+    const size_t window = FUSE_WINDOW        // max lead of decryption chain
 ) {
-  skinny::state_t st;
+  skinny::state_t dst;  // decryption chain
+  skinny::state_t mst;  // MAC chain
+  skinny::tweakey_schedule_t ts;
 
-  uint8_t lfsr[7];
+  uint64_t dlfsr = romulus_common::LFSR_INIT;
+  uint64_t mlfsr = snap->lfsr;
   uint8_t enc[16];
 
-  if (ctlen > 0ul) {
-    romulus_common::set_lfsr(lfsr);
-
-    std::memcpy(st.arr, tag, 16);
-
-    const size_t blk_cnt = ctlen >> 4;
-    const size_t rm_bytes = ctlen & 15ul;
-
-    const bool flg = (ctlen == 0) | (rm_bytes > 0);
-    const size_t tot_blk_cnt = blk_cnt + 1ul * flg;
-
-    size_t off = 0ul;
-
-    for (size_t i = 0; i < tot_blk_cnt - 1; i++) {
-      romulus_common::encode(key, nonce, lfsr, 36, st.arr + 16);
+  // decryption chain's TBC calls, which aren't paired with MAC chain's, only
+  // use tweakey state (1) of `dst`, see skinny::expand_tk2
+  skinny_rows::expand_tk2(&ts, nonce, ks);
 
-      skinny::tbc(&st);
+  std::memcpy(dst.arr, tag, 16);
+  std::memcpy(mst.arr, snap->st, 16);
 
-      romulus_common::rho_inv(st.arr, cipher + off, text + off);
-      romulus_common::update_lfsr(lfsr);
+  const size_t ct_blk_cnt = ctlen >> 4;
+  const size_t ct_rm_bytes = ctlen & 15ul;
 
-      off += 16;
-    }
+  const bool flg1 = (ctlen == 0) | (ct_rm_bytes > 0);
 
-    const size_t read = ctlen - off;
+  const size_t tot_ct_blk_cnt = ct_blk_cnt + 1ul * flg1;
 
-    uint8_t blk[16]{};
+  uint8_t w = snap->d_sep;
 
-    std::memset(blk, 0, 16);
-    std::memcpy(blk, cipher + off, read);
+  w ^= 1 * flg1;
+  w ^= 4 * (1 - (tot_ct_blk_cnt & 1));
 
-    const uint8_t br[]{blk[15], static_cast<uint8_t>(read)};
-    blk[15] = br[read < 16ul];
+  const size_t tot_blk_cnt = tot_ad_blk_cnt + tot_ct_blk_cnt;
+  const size_t half_blk_cnt = tot_blk_cnt >> 1;
+  const size_t half_ad_blk_cnt = tot_ad_blk_cnt >> 1;
 
-    romulus_common::encode(key, nonce, lfsr, 36, st.arr + 16);
+  const bool flg2 = static_cast<bool>(tot_ad_blk_cnt & 1ul);
+  const bool flg3 = static_cast<bool>(tot_ct_blk_cnt & 1ul);
 
-    skinny::tbc(&st);
+  // # -of TBC calls in decryption chain and in MAC chain
+  const size_t dec_cnt = tot_ct_blk_cnt * (ctlen > 0ul);
+  const size_t mac_cnt = half_blk_cnt + 1ul;
 
-    romulus_common::rho_inv(st.arr, blk, enc);
-    std::memcpy(text + off, enc, read);
-  }
+  // # -of decrypted text bytes, required for i -th TBC call of MAC chain
+  auto required = [&](const size_t i) -> size_t {
+    const bool last = i == half_blk_cnt;
+    const size_t blk_idx = last ? tot_blk_cnt - 1 : (i << 1) ^ 1ul;
 
-  {
-    std::memset(st.arr, 0, 16);
-    romulus_common::set_lfsr(lfsr);
+    if ((last & (flg2 == flg3)) | (blk_idx < tot_ad_blk_cnt)) {
+      return 0ul;
+    }
+    return std::min(ctlen, (blk_idx - tot_ad_blk_cnt + 1) << 4);
+  };
 
-    const size_t ad_blk_cnt = dlen >> 4;
-    const size_t ct_blk_cnt = ctlen >> 4;
+  romulus_common::blocks_t cit;
+  romulus_common::init_blocks(&cit, cipher, ctlen, nullptr, 0ul,
+                              romulus_common::pad_t::romulusm);
 
-    const size_t ad_rm_bytes = dlen & 15ul;
-    const size_t ct_rm_bytes = ctlen & 15ul;
+  constexpr uint8_t zeros[16]{};
+  uint8_t x = 40;
 
-    const bool flg0 = (dlen == 0) | (ad_rm_bytes > 0);
-    const bool flg1 = (ctlen == 0) | (ct_rm_bytes > 0);
+  size_t di = 0;
+  size_t mi = 0;
 
-    const size_t tot_ad_blk_cnt = ad_blk_cnt + 1ul * flg0;
-    const size_t tot_ct_blk_cnt = ct_blk_cnt + 1ul * flg1;
+  while ((di < dec_cnt) || (mi < mac_cnt)) {
+    const size_t avail = std::min(ctlen, di << 4);
 
-    uint8_t w = 48;
+    const size_t req = mi < mac_cnt ? required(mi) : ctlen;
 
-    w ^= 2 * flg0;
-    w ^= 1 * flg1;
-    w ^= 8 * (1 - (tot_ad_blk_cnt & 1));
-    w ^= 4 * (1 - (tot_ct_blk_cnt & 1));
+    const bool dec = (di < dec_cnt) && ((di << 4) < req + window);
+    const bool mac = (mi < mac_cnt) && (req <= avail);
 
-    const size_t tot_blk_cnt = tot_ad_blk_cnt + tot_ct_blk_cnt;
-    const size_t half_blk_cnt = tot_blk_cnt >> 1;
-    const size_t half_ad_blk_cnt = tot_ad_blk_cnt >> 1;
+    if (dec) {
+      romulus_common::encode(nonce, dlfsr, 36, dst.arr + 16);
+    }
 
-    uint8_t blk[16]{};
-    uint8_t x = 40;
+    if (mac && (mi < half_blk_cnt)) {
+      romulus_common::rho(mst.arr, romulus_common::next_block(it), enc);
+      mlfsr = romulus_common::step_lfsr(mlfsr);
 
-    for (size_t i = 0; i < half_blk_cnt; i++) {
-      get_auth_block(data, dlen, text, ctlen, (i << 1) ^ 0ul, blk);
+      x ^= 4 * (mi == half_ad_blk_cnt);
 
-      romulus_common::rho(st.arr, blk, enc);
-      romulus_common::update_lfsr(lfsr);
+      const uint8_t* const ablk = romulus_common::next_block(it);
+      romulus_common::encode(ablk, mlfsr, x, mst.arr + 16);
+    } else if (mac) {
+      const uint8_t* const ablk =
+          flg2 == flg3 ? zeros : romulus_common::next_block(it);
 
-      x ^= 4 * (i == half_ad_blk_cnt);
+      romulus_common::rho(mst.arr, ablk, enc);
 
-      get_auth_block(data, dlen, text, ctlen, (i << 1) ^ 1ul, blk);
-      romulus_common::encode(key, blk, lfsr, x, st.arr + 16);
+      if (tot_blk_cnt > (half_blk_cnt << 1)) {
+        mlfsr = romulus_common::step_lfsr(mlfsr);
+      }
 
-      skinny::tbc(&st);
-      romulus_common::update_lfsr(lfsr);
+      romulus_common::encode(nonce, mlfsr, w, mst.arr + 16);
     }
 
-    const bool flg2 = static_cast<bool>(tot_ad_blk_cnt & 1ul);
-    const bool flg3 = static_cast<bool>(tot_ct_blk_cnt & 1ul);
-
-    if (flg2 == flg3) {
-      std::memset(blk, 0, 16);
+    if (dec && mac) {
+      skinny_simd::tbc_pair(&dst, &mst, ks);
+    } else if (dec) {
+      skinny_simd::tbc(&dst, &ts);
     } else {
-      get_auth_block(data, dlen, text, ctlen, tot_blk_cnt - 1, blk);
+      skinny_simd::tbc(&mst, ks);
     }
 
-    romulus_common::rho(st.arr, blk, enc);
+    if (dec) {
+      const size_t off = di << 4;
+      const size_t read = std::min(16ul, ctlen - off);
 
-    if (tot_blk_cnt > (half_blk_cnt << 1)) {
-      romulus_common::update_lfsr(lfsr);
-    }
+      const uint8_t* const cblk = romulus_common::next_block(&cit);
 
-    romulus_common::encode(key, nonce, lfsr, w, st.arr + 16);
+      if (read == 16ul) {
+        romulus_common::rho_inv(dst.arr, cblk, text + off);
+      } else {
+        romulus_common::rho_inv(dst.arr, cblk, enc);
+        std::memcpy(text + off, enc, read);
+      }
+
+      dlfsr = romulus_common::step_lfsr(dlfsr);
+      di++;
+    }
 
-    skinny::tbc(&st);
+    if (mac) {
+      if (mi < half_blk_cnt) {
+        mlfsr = romulus_common::step_lfsr(mlfsr);
+      }
+      mi++;
+    }
   }
 
   uint8_t tmp[16]{};
   uint8_t tag_[16]{};
 
-  std::memset(tmp, 0, 16);
-  std::memset(tag_, 0, 16);
-
-  romulus_common::rho(st.arr, tmp, tag_);
+  romulus_common::rho(mst.arr, tmp, tag_);
 
   bool flg = false;
   for (size_t i = 0; i < 16; i++) {
@@ -334,4 +437,69 @@ static bool decrypt(
   return !flg;
 }
 
+// Given expanded secret key ( see skinny::expand_tk3 ), already absorbed
+// associated data ( see `absorb` ), 16 -bytes nonce, 16 -bytes authentication
+// tag and M -bytes encrypted text | M >= 0, this routine computes M -bytes
+// decrypted text and boolean verification flag, using Romulus-M verified
+// decryption algorithm, without absorbing associated data or expanding secret
+// key again
+inline static bool decrypt(
+    const skinny::key_schedule_t* const __restrict ks,  // expanded secret key
+    const ad_snapshot_t* const __restrict snap,  // absorbed associated data
+    const uint8_t* const __restrict nonce,       // 128 -bit message nonce
+    const uint8_t* const __restrict tag,         // 128 -bit authentication tag
+    const uint8_t* const __restrict cipher,      // M -bytes encrypted text
+    uint8_t* const text,                         // M -bytes decrypted text
+    const size_t ctlen                           // len(text) = len(cipher)
+) {
+  romulus_common::blocks_t it;
+  init_blocks(&it, snap, text, ctlen);
+
+  return decrypt(ks, nonce, tag, snap, &it, 1ul * snap->odd, cipher, text,
+                 ctlen);
+}
+
+// Given 16 -bytes secret key, 16 -bytes nonce, 16 -bytes authentication tag, N
+// -bytes associated data and M -bytes encrypted text | N, M >= 0, this routine
+// computes M -bytes decrypted text and boolean verification flag, using
+// Romulus-M verified decryption algorithm, which is nonce misuse-resistant.
+// MAC chain starts from scratch, so that associated data is absorbed while
+// cipher text is being decrypted, see above.
+static bool decrypt(
+    const uint8_t* const __restrict key,     // 128 -bit secret key
+    const uint8_t* const __restrict nonce,   // 128 -bit public message nonce
+    const uint8_t* const __restrict tag,     // 128 -bit authentication tag
+    const uint8_t* const __restrict data,    // N -bytes associated data
+    const size_t dlen,                       // len(data) = N | >= 0
+    const uint8_t* const __restrict cipher,  // M -bytes encrypted text
+    uint8_t* const __restrict text,          // M -bytes decrypted text
+    const size_t ctlen                       // len(text) = len(cipher) | >= 0
+) {
+  skinny::key_schedule_t ks;
+  skinny::expand_tk3(&ks, key);
+
+  const size_t ad_blk_cnt = dlen >> 4;
+  const size_t ad_rm_bytes = dlen & 15ul;
+
+  const bool flg0 = (dlen == 0) | (ad_rm_bytes > 0);
+  const size_t tot_ad_blk_cnt = ad_blk_cnt + 1ul * flg0;
+
+  // nothing absorbed yet
+  ad_snapshot_t snap;
+
+  std::memset(snap.st, 0, 16);
+  snap.lfsr = romulus_common::LFSR_INIT;
+  snap.d_sep = 48;
+
+  snap.d_sep ^= 2 * flg0;
+  snap.d_sep ^= 8 * (1 - (tot_ad_blk_cnt & 1));
+
+  romulus_common::blocks_t it;
+  romulus_common::init_blocks(&it, data, dlen, text, ctlen,
+                              romulus_common::pad_t::romulusm);
+
+  return decrypt(&ks, nonce, tag, &snap, &it, tot_ad_blk_cnt, cipher, text,
+                 ctlen);
+}
+
 }  // namespace romulusm
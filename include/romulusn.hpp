@@ -1,94 +1,154 @@
 #pragma once
 #include <algorithm>
+#include <cassert>
 
 #include "common.hpp"
 #include "skinny.hpp"
+#include "skinny_bitsliced.hpp"
+#include "skinny_simd.hpp"
 
 // Romulus-N Authenticated Encryption with Associated Data
 namespace romulusn {
 
-// Given 16 -bytes secret key, 16 -bytes nonce, N -bytes associated data and M
-// -bytes plain text | N, M >= 0, this routine computes M -bytes encrypted text
-// and 16 -bytes authentication tag, using Romulus-N authenticated encryption
-// algorithm
+// Romulus-N context, holding everything which depends only on secret key, so
+// that it can be computed once per key and used for encrypting/ decrypting any
+// number of messages
+struct context_t {
+  skinny::key_schedule_t ks;  // round tweakeys of tweakey state (3) i.e. key
+};
+
+// Given 16 -bytes secret key, this routine prepares Romulus-N context, by
+// expanding secret key ( used as tweakey state (3) ) into round tweakeys
+inline static void setup(
+    context_t* const __restrict ctx,     // Romulus-N context ( computed )
+    const uint8_t* const __restrict key  // 128 -bit secret key
+) {
+  skinny::expand_tk3(&ctx->ks, key);
+}
+
+// Associated data absorbed into Romulus-N state, which depends only on secret
+// key and associated data, but not on nonce, so that associated data repeated
+// across many messages ( say a fixed protocol header ) can be absorbed only
+// once, see `absorb`, and each message starts from it, see `encrypt`/
+// `decrypt` routines taking it
+struct ad_snapshot_t {
+  uint8_t st[16];  // internal state, after absorbing all associated data
+  uint64_t lfsr;   // packed 56 -bit LFSR counter
+  uint8_t d_sep;   // domain seperator of TBC call finishing associated data
+};
+
+// Given Romulus-N context ( holding expanded secret key ) and N -bytes
+// associated data | N >= 0, this routine absorbs all associated data blocks,
+// stopping right before the TBC call which uses nonce as tweak, computing a
+// snapshot, which can be used for encrypting/ decrypting any number of
+// messages, under any nonce
 //
-// See encryption algorithm defined in figure 2.5 of Romulus specification
+// See first part of encryption algorithm defined in figure 2.5 of Romulus
+// specification
 // https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/romulus-spec-final.pdf
-inline static void encrypt(
-    const uint8_t* const __restrict key,    // 128 -bit secret key
-    const uint8_t* const __restrict nonce,  // 128 -bit public message nonce
+inline static void absorb(
+    ad_snapshot_t* const __restrict snap,   // associated data ( computed )
+    const context_t* const __restrict ctx,  // expanded 128 -bit secret key
     const uint8_t* const __restrict data,   // N -bytes associated data
-    const size_t dlen,                      // len(data) | >= 0
-    const uint8_t* const __restrict txt,    // N -bytes plain text
-    uint8_t* const __restrict cipher,       // N -bytes encrypted text
-    const size_t ctlen,                     // len(txt) = len(cipher) | >= 0
-    uint8_t* const __restrict tag           // 128 -bit authentication tag
+    const size_t dlen                       // len(data) | >= 0
 ) {
   skinny::state_t st;
 
-  uint8_t lfsr[7];
+  uint64_t lfsr = romulus_common::LFSR_INIT;
   uint8_t enc[16];
   uint8_t last_blk[16];
 
   std::memset(st.arr, 0, 16);
-  romulus_common::set_lfsr(lfsr);
 
-  {
-    constexpr size_t br0[2] = {0, 1};
+  constexpr size_t br0[2] = {0, 1};
 
-    const size_t full_blk_cnt = dlen >> 4;
-    const size_t rm_bytes = dlen & 15;
+  const size_t full_blk_cnt = dlen >> 4;
+  const size_t rm_bytes = dlen & 15;
 
-    const bool flg = (dlen == 0) | (rm_bytes > 0);
+  const bool flg = (dlen == 0) | (rm_bytes > 0);
 
-    const size_t tot_blk_cnt = full_blk_cnt + br0[flg];
-    const size_t half_blk_cnt = tot_blk_cnt >> 1;
+  const size_t tot_blk_cnt = full_blk_cnt + br0[flg];
+  const size_t half_blk_cnt = tot_blk_cnt >> 1;
 
-    size_t off = 0;
+  size_t off = 0;
 
-    for (size_t i = 0; i < half_blk_cnt; i++) {
-      uint8_t right_blk[16];
-      std::memset(right_blk, 0, 16);
+  for (size_t i = 0; i < half_blk_cnt; i++) {
+    uint8_t right_blk[16];
+    std::memset(right_blk, 0, 16);
 
-      const size_t off0 = off;
-      const size_t off1 = off + 16ul;
+    const size_t off0 = off;
+    const size_t off1 = off + 16ul;
 
-      romulus_common::rho(st.arr, data + off0, enc);
-      romulus_common::update_lfsr(lfsr);
+    romulus_common::rho(st.arr, data + off0, enc);
+    lfsr = romulus_common::step_lfsr(lfsr);
 
-      const size_t to_read = std::min(16ul, dlen - off1);
-      std::memcpy(right_blk, data + off1, to_read);
+    const size_t to_read = std::min(16ul, dlen - off1);
+    std::memcpy(right_blk, data + off1, to_read);
 
-      off = off1 + to_read;
+    off = off1 + to_read;
 
-      const size_t br1[2] = {right_blk[15], to_read};
-      right_blk[15] = br1[to_read < 16];
+    const size_t br1[2] = {right_blk[15], to_read};
+    right_blk[15] = br1[to_read < 16];
 
-      romulus_common::encode(key, right_blk, lfsr, 8, st.arr + 16);
+    romulus_common::encode(right_blk, lfsr, 8, st.arr + 16);
 
-      skinny::tbc(&st);
-      romulus_common::update_lfsr(lfsr);
-    }
+    skinny_simd::tbc(&st, &ctx->ks);
+    lfsr = romulus_common::step_lfsr(lfsr);
+  }
 
-    const size_t to_read = dlen - off;
+  const size_t to_read = dlen - off;
 
-    std::memset(last_blk, 0, 16);
-    std::memcpy(last_blk, data + off, to_read);
+  std::memset(last_blk, 0, 16);
+  std::memcpy(last_blk, data + off, to_read);
 
-    const size_t br2[2] = {last_blk[15], to_read};
-    last_blk[15] = br2[to_read < 16];
+  const size_t br2[2] = {last_blk[15], to_read};
+  last_blk[15] = br2[to_read < 16];
 
-    romulus_common::rho(st.arr, last_blk, enc);
+  romulus_common::rho(st.arr, last_blk, enc);
 
-    if (tot_blk_cnt > (half_blk_cnt << 1)) {
-      romulus_common::update_lfsr(lfsr);
-    }
+  if (tot_blk_cnt > (half_blk_cnt << 1)) {
+    lfsr = romulus_common::step_lfsr(lfsr);
+  }
 
-    constexpr size_t br3[2] = {24, 26};
-    romulus_common::encode(key, nonce, lfsr, br3[flg], st.arr + 16);
+  std::memcpy(snap->st, st.arr, 16);
+  snap->lfsr = lfsr;
 
-    skinny::tbc(&st);
-  }
+  constexpr uint8_t br3[2] = {24, 26};
+  snap->d_sep = br3[flg];
+}
+
+// Given Romulus-N context ( holding expanded secret key ), already absorbed
+// associated data, 16 -bytes nonce and M -bytes plain text | M >= 0, this
+// routine computes M -bytes encrypted text and 16 -bytes authentication tag,
+// using Romulus-N authenticated encryption algorithm
+//
+// See encryption algorithm defined in figure 2.5 of Romulus specification
+// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/romulus-spec-final.pdf
+inline static void encrypt(
+    const context_t* const __restrict ctx,       // expanded 128 -bit key
+    const ad_snapshot_t* const __restrict snap,  // absorbed associated data
+    const uint8_t* const __restrict nonce,       // 128 -bit message nonce
+    const uint8_t* const __restrict txt,         // M -bytes plain text
+    uint8_t* const __restrict cipher,            // M -bytes encrypted text
+    const size_t ctlen,                          // len(txt) = len(cipher)
+    uint8_t* const __restrict tag                // 128 -bit authentication tag
+) {
+  skinny::state_t st;
+  skinny::tweakey_schedule_t ts;
+
+  uint8_t lfsr[7];
+  uint8_t enc[16];
+  uint8_t last_blk[16];
+
+  std::memcpy(st.arr, snap->st, 16);
+
+  // nonce and secret key are tweakey state (2, 3) of all remaining TBC calls,
+  // so their round tweakeys are combined only once and each of those calls
+  // only encodes tweakey state (1)
+  skinny_rows::expand_tk2(&ts, nonce, &ctx->ks);
+
+  romulus_common::encode(snap->lfsr, snap->d_sep, st.arr + 16);
+  skinny_simd::tbc(&st, &ts);
 
   romulus_common::set_lfsr(lfsr);
 
@@ -108,9 +168,9 @@ inline static void encrypt(
       romulus_common::rho(st.arr, txt + off, cipher + off);
       romulus_common::update_lfsr(lfsr);
 
-      romulus_common::encode(key, nonce, lfsr, 4, st.arr + 16);
+      romulus_common::encode(lfsr, 4, st.arr + 16);
 
-      skinny::tbc(&st);
+      skinny_simd::tbc(&st, &ts);
       off += 16;
     }
 
@@ -129,9 +189,9 @@ inline static void encrypt(
     romulus_common::update_lfsr(lfsr);
 
     constexpr size_t br2[2] = {20, 21};
-    romulus_common::encode(key, nonce, lfsr, br2[flg], st.arr + 16);
+    romulus_common::encode(lfsr, br2[flg], st.arr + 16);
 
-    skinny::tbc(&st);
+    skinny_simd::tbc(&st, &ts);
   }
 
   uint8_t tmp[16];
@@ -140,88 +200,38 @@ inline static void encrypt(
   romulus_common::rho(st.arr, tmp, tag);
 }
 
-// Given 16 -bytes secret key, 16 -bytes nonce, 16 -bytes authentication tag, N
-// -bytes associated data and M -bytes encrypted text | N, M >= 0, this routine
-// computes M -bytes decrypted text and boolean verification flag, using
-// Romulus-N verified decryption algorithm
+// Given Romulus-N context ( holding expanded secret key ), already absorbed
+// associated data, 16 -bytes nonce, 16 -bytes authentication tag and M -bytes
+// encrypted text | M >= 0, this routine computes M -bytes decrypted text and
+// boolean verification flag, using Romulus-N verified decryption algorithm
 //
 // See decryption algorithm defined in figure 2.5 of Romulus specification
 // https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/romulus-spec-final.pdf
 inline static bool decrypt(
-    const uint8_t* const __restrict key,     // 128 -bit secret key
-    const uint8_t* const __restrict nonce,   // 128 -bit public message nonce
-    const uint8_t* const __restrict tag,     // 128 -bit authentication tag
-    const uint8_t* const __restrict data,    // N -bytes associated data
-    const size_t dlen,                       // len(data) | >= 0
-    const uint8_t* const __restrict cipher,  // N -bytes encrypted text
-    uint8_t* const __restrict txt,           // N -bytes plain text
-    const size_t ctlen                       // len(cipher) = len(txt) | >= 0
+    const context_t* const __restrict ctx,       // expanded 128 -bit key
+    const ad_snapshot_t* const __restrict snap,  // absorbed associated data
+    const uint8_t* const __restrict nonce,       // 128 -bit message nonce
+    const uint8_t* const __restrict tag,         // 128 -bit authentication tag
+    const uint8_t* const __restrict cipher,      // M -bytes encrypted text
+    uint8_t* const __restrict txt,               // M -bytes plain text
+    const size_t ctlen                           // len(cipher) = len(txt)
 ) {
   skinny::state_t st;
+  skinny::tweakey_schedule_t ts;
 
   uint8_t lfsr[7];
   uint8_t enc[16];
   uint8_t last_blk[16];
 
-  std::memset(st.arr, 0, 16);
-  romulus_common::set_lfsr(lfsr);
-
-  {
-    constexpr size_t br0[2] = {0, 1};
-
-    const size_t full_blk_cnt = dlen >> 4;
-    const size_t rm_bytes = dlen & 15;
-
-    const bool flg = (dlen == 0) | (rm_bytes > 0);
+  std::memcpy(st.arr, snap->st, 16);
 
-    const size_t tot_blk_cnt = full_blk_cnt + br0[flg];
-    const size_t half_blk_cnt = tot_blk_cnt >> 1;
-
-    size_t off = 0;
+  // nonce and secret key are tweakey state (2, 3) of all remaining TBC calls,
+  // so their round tweakeys are combined only once and each of those calls
+  // only encodes tweakey state (1)
+  skinny_rows::expand_tk2(&ts, nonce, &ctx->ks);
 
-    for (size_t i = 0; i < half_blk_cnt; i++) {
-      uint8_t right_blk[16];
-      std::memset(right_blk, 0, 16);
-
-      const size_t off0 = off;
-      const size_t off1 = off + 16ul;
-
-      romulus_common::rho(st.arr, data + off0, enc);
-      romulus_common::update_lfsr(lfsr);
-
-      const size_t to_read = std::min(16ul, dlen - off1);
-      std::memcpy(right_blk, data + off1, to_read);
-
-      off = off1 + to_read;
-
-      const size_t br1[2] = {right_blk[15], to_read};
-      right_blk[15] = br1[to_read < 16];
-
-      romulus_common::encode(key, right_blk, lfsr, 8, st.arr + 16);
-
-      skinny::tbc(&st);
-      romulus_common::update_lfsr(lfsr);
-    }
-
-    const size_t to_read = dlen - off;
-
-    std::memset(last_blk, 0, 16);
-    std::memcpy(last_blk, data + off, to_read);
-
-    const size_t br2[2] = {last_blk[15], to_read};
-    last_blk[15] = br2[to_read < 16];
-
-    romulus_common::rho(st.arr, last_blk, enc);
-
-    if (tot_blk_cnt > (half_blk_cnt << 1)) {
-      romulus_common::update_lfsr(lfsr);
-    }
-
-    constexpr size_t br3[2] = {24, 26};
-    romulus_common::encode(key, nonce, lfsr, br3[flg], st.arr + 16);
-
-    skinny::tbc(&st);
-  }
+  romulus_common::encode(snap->lfsr, snap->d_sep, st.arr + 16);
+  skinny_simd::tbc(&st, &ts);
 
   romulus_common::set_lfsr(lfsr);
 
@@ -241,9 +251,9 @@ inline static bool decrypt(
       romulus_common::rho_inv(st.arr, cipher + off, txt + off);
       romulus_common::update_lfsr(lfsr);
 
-      romulus_common::encode(key, nonce, lfsr, 4, st.arr + 16);
+      romulus_common::encode(lfsr, 4, st.arr + 16);
 
-      skinny::tbc(&st);
+      skinny_simd::tbc(&st, &ts);
       off += 16;
     }
 
@@ -280,9 +290,9 @@ inline static bool decrypt(
     romulus_common::update_lfsr(lfsr);
 
     constexpr size_t br2[2] = {20, 21};
-    romulus_common::encode(key, nonce, lfsr, br2[flg], st.arr + 16);
+    romulus_common::encode(lfsr, br2[flg], st.arr + 16);
 
-    skinny::tbc(&st);
+    skinny_simd::tbc(&st, &ts);
   }
 
   uint8_t tmp[16];
@@ -302,4 +312,636 @@ inline static bool decrypt(
   return !flg;
 }
 
+// Given Romulus-N context ( holding expanded secret key ), 16 -bytes nonce, N
+// -bytes associated data and M -bytes plain text | N, M >= 0, this routine
+// computes M -bytes encrypted text and 16 -bytes authentication tag, using
+// Romulus-N authenticated encryption algorithm
+//
+// See encryption algorithm defined in figure 2.5 of Romulus specification
+// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/romulus-spec-final.pdf
+inline static void encrypt(
+    const context_t* const __restrict ctx,  // expanded 128 -bit secret key
+    const uint8_t* const __restrict nonce,  // 128 -bit public message nonce
+    const uint8_t* const __restrict data,   // N -bytes associated data
+    const size_t dlen,                      // len(data) | >= 0
+    const uint8_t* const __restrict txt,    // N -bytes plain text
+    uint8_t* const __restrict cipher,       // N -bytes encrypted text
+    const size_t ctlen,                     // len(txt) = len(cipher) | >= 0
+    uint8_t* const __restrict tag           // 128 -bit authentication tag
+) {
+  ad_snapshot_t snap;
+  absorb(&snap, ctx, data, dlen);
+
+  encrypt(ctx, &snap, nonce, txt, cipher, ctlen, tag);
+}
+
+// Given Romulus-N context ( holding expanded secret key ), 16 -bytes nonce, 16
+// -bytes authentication tag, N -bytes associated data and M -bytes encrypted
+// text | N, M >= 0, this routine computes M -bytes decrypted text and boolean
+// verification flag, using Romulus-N verified decryption algorithm
+//
+// See decryption algorithm defined in figure 2.5 of Romulus specification
+// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/romulus-spec-final.pdf
+inline static bool decrypt(
+    const context_t* const __restrict ctx,   // expanded 128 -bit secret key
+    const uint8_t* const __restrict nonce,   // 128 -bit public message nonce
+    const uint8_t* const __restrict tag,     // 128 -bit authentication tag
+    const uint8_t* const __restrict data,    // N -bytes associated data
+    const size_t dlen,                       // len(data) | >= 0
+    const uint8_t* const __restrict cipher,  // N -bytes encrypted text
+    uint8_t* const __restrict txt,           // N -bytes plain text
+    const size_t ctlen                       // len(cipher) = len(txt) | >= 0
+) {
+  ad_snapshot_t snap;
+  absorb(&snap, ctx, data, dlen);
+
+  return decrypt(ctx, &snap, nonce, tag, cipher, txt, ctlen);
+}
+
+// Given 16 -bytes secret key, 16 -bytes nonce, N -bytes associated data and M
+// -bytes plain text | N, M >= 0, this routine computes M -bytes encrypted text
+// and 16 -bytes authentication tag, using Romulus-N authenticated encryption
+// algorithm. Prefer preparing a context once per key, when encrypting many
+// messages under same key.
+//
+// See encryption algorithm defined in figure 2.5 of Romulus specification
+// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/romulus-spec-final.pdf
+inline static void encrypt(
+    const uint8_t* const __restrict key,    // 128 -bit secret key
+    const uint8_t* const __restrict nonce,  // 128 -bit public message nonce
+    const uint8_t* const __restrict data,   // N -bytes associated data
+    const size_t dlen,                      // len(data) | >= 0
+    const uint8_t* const __restrict txt,    // N -bytes plain text
+    uint8_t* const __restrict cipher,       // N -bytes encrypted text
+    const size_t ctlen,                     // len(txt) = len(cipher) | >= 0
+    uint8_t* const __restrict tag           // 128 -bit authentication tag
+) {
+  context_t ctx;
+  setup(&ctx, key);
+
+  encrypt(&ctx, nonce, data, dlen, txt, cipher, ctlen, tag);
+}
+
+// Given 16 -bytes secret key, 16 -bytes nonce, 16 -bytes authentication tag, N
+// -bytes associated data and M -bytes encrypted text | N, M >= 0, this routine
+// computes M -bytes decrypted text and boolean verification flag, using
+// Romulus-N verified decryption algorithm. Prefer preparing a context once per
+// key, when decrypting many messages under same key.
+//
+// See decryption algorithm defined in figure 2.5 of Romulus specification
+// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/romulus-spec-final.pdf
+inline static bool decrypt(
+    const uint8_t* const __restrict key,     // 128 -bit secret key
+    const uint8_t* const __restrict nonce,   // 128 -bit public message nonce
+    const uint8_t* const __restrict tag,     // 128 -bit authentication tag
+    const uint8_t* const __restrict data,    // N -bytes associated data
+    const size_t dlen,                       // len(data) | >= 0
+    const uint8_t* const __restrict cipher,  // N -bytes encrypted text
+    uint8_t* const __restrict txt,           // N -bytes plain text
+    const size_t ctlen                       // len(cipher) = len(txt) | >= 0
+) {
+  context_t ctx;
+  setup(&ctx, key);
+
+  return decrypt(&ctx, nonce, tag, data, dlen, cipher, txt, ctlen);
+}
+
+// Incremental Romulus-N state, which allows associated data and plain/ cipher
+// text to be supplied in arbitrary sized chunks, carrying partially filled
+// block and 56 -bit LFSR counter across calls, producing same output as
+// one-shot `encrypt`/ `decrypt` routines
+//
+// Expected call sequence is `init` -> `absorb_ad`* -> `encrypt_update`* ->
+// `finalize` ( for encryption ) or `init` -> `absorb_ad`* -> `decrypt_update`*
+// -> `verify` ( for decryption ).
+struct stream_t {
+  skinny::state_t st;
+  const context_t* ctx;           // must outlive this stream
+  skinny::tweakey_schedule_t ts;  // round tweakeys of nonce and secret key
+  uint8_t lfsr[7];
+  uint8_t buf[32];  // associated data bytes, not yet absorbed
+  size_t blen;      // number of bytes in `buf` | < 32
+  size_t dlen;      // total number of associated data bytes absorbed
+  size_t moff;      // offset in current plain/ cipher text block | <= 16
+  bool ad_done;     // all associated data bytes are absorbed
+};
+
+// Given Romulus-N context ( holding expanded secret key ) and 16 -bytes nonce,
+// this routine prepares incremental Romulus-N state for processing a message
+inline static void init(
+    stream_t* const __restrict strm,        // Romulus-N stream ( computed )
+    const context_t* const __restrict ctx,  // expanded 128 -bit secret key
+    const uint8_t* const __restrict nonce   // 128 -bit public message nonce
+) {
+  std::memset(strm->st.arr, 0, 16);
+  romulus_common::set_lfsr(strm->lfsr);
+
+  strm->ctx = ctx;
+  skinny_rows::expand_tk2(&strm->ts, nonce, &ctx->ks);
+
+  strm->blen = 0;
+  strm->dlen = 0;
+  strm->moff = 0;
+  strm->ad_done = false;
+}
+
+// Absorbs a pair of 16 -bytes associated data blocks, where right block is
+// used as tweak, see first loop of encryption algorithm in figure 2.5 of
+// Romulus specification
+inline static void absorb_ad_pair(
+    stream_t* const __restrict strm,       // Romulus-N stream
+    const uint8_t* const __restrict left,  // 16 -bytes associated data block
+    const uint8_t* const __restrict right  // 16 -bytes ( padded ) block
+) {
+  uint8_t enc[16];
+
+  romulus_common::rho(strm->st.arr, left, enc);
+  romulus_common::update_lfsr(strm->lfsr);
+
+  romulus_common::encode(right, strm->lfsr, 8, strm->st.arr + 16);
+
+  skinny_simd::tbc(&strm->st, &strm->ctx->ks);
+  romulus_common::update_lfsr(strm->lfsr);
+}
+
+// Absorbs N -bytes associated data into incremental Romulus-N state | N >= 0,
+// which can be called any number of times, before plain/ cipher text is
+// supplied. Calling it after that breaks MAC chain, which is asserted against.
+inline static void absorb_ad(
+    stream_t* const __restrict strm,       // Romulus-N stream
+    const uint8_t* const __restrict data,  // N -bytes associated data
+    const size_t dlen                      // len(data) | >= 0
+) {
+  assert(!strm->ad_done);
+
+  size_t off = 0;
+
+  strm->dlen += dlen;
+
+  if (strm->blen > 0) {
+    const size_t to_read = std::min(32ul - strm->blen, dlen);
+
+    std::memcpy(strm->buf + strm->blen, data, to_read);
+    strm->blen += to_read;
+    off += to_read;
+
+    if (strm->blen < 32) {
+      return;
+    }
+
+    absorb_ad_pair(strm, strm->buf, strm->buf + 16);
+    strm->blen = 0;
+  }
+
+  while (dlen - off >= 32) {
+    absorb_ad_pair(strm, data + off, data + off + 16);
+    off += 32;
+  }
+
+  std::memcpy(strm->buf, data + off, dlen - off);
+  strm->blen = dlen - off;
+}
+
+// Absorbs remaining ( < 32 ) associated data bytes, padding them as required,
+// followed by encrypting internal state with nonce as tweak, which finishes
+// associated data processing. LFSR counter is reset for message processing.
+inline static void finish_ad(stream_t* const __restrict strm) {
+  uint8_t enc[16];
+  uint8_t last_blk[16];
+
+  const size_t rm = strm->blen;
+
+  // 56 -bit LFSR counter is updated only when total block count is odd
+  if (rm > 16) {
+    std::memset(last_blk, 0, 16);
+    std::memcpy(last_blk, strm->buf + 16, rm - 16);
+    last_blk[15] = static_cast<uint8_t>(rm - 16);
+
+    absorb_ad_pair(strm, strm->buf, last_blk);
+  } else if ((rm > 0) | (strm->dlen == 0)) {
+    std::memset(last_blk, 0, 16);
+    std::memcpy(last_blk, strm->buf, rm);
+
+    const uint8_t br[2] = {last_blk[15], static_cast<uint8_t>(rm)};
+    last_blk[15] = br[rm < 16];
+
+    romulus_common::rho(strm->st.arr, last_blk, enc);
+    romulus_common::update_lfsr(strm->lfsr);
+  }
+
+  const bool flg = (strm->dlen == 0) | ((strm->dlen & 15) > 0);
+
+  constexpr uint8_t br[2] = {24, 26};
+  romulus_common::encode(strm->lfsr, br[flg], strm->st.arr + 16);
+
+  skinny_simd::tbc(&strm->st, &strm->ts);
+
+  romulus_common::set_lfsr(strm->lfsr);
+  strm->blen = 0;
+  strm->ad_done = true;
+}
+
+// Encrypts internal state, when a full plain/ cipher text block is already
+// processed and more bytes are now available, so that it's not the last block
+inline static void next_msg_block(stream_t* const __restrict strm) {
+  romulus_common::update_lfsr(strm->lfsr);
+  romulus_common::encode(strm->lfsr, 4, strm->st.arr + 16);
+
+  skinny_simd::tbc(&strm->st, &strm->ts);
+  strm->moff = 0;
+}
+
+// Encrypts N -bytes plain text using incremental Romulus-N state | N >= 0,
+// producing N -bytes encrypted text, which can be called any number of times
+inline static void encrypt_update(
+    stream_t* const __restrict strm,      // Romulus-N stream
+    const uint8_t* const __restrict txt,  // N -bytes plain text
+    uint8_t* const __restrict cipher,     // N -bytes encrypted text
+    const size_t ctlen                    // len(txt) = len(cipher) | >= 0
+) {
+  if (!strm->ad_done) {
+    finish_ad(strm);
+  }
+
+  size_t off = 0;
+
+  while (off < ctlen) {
+    if (strm->moff == 16) {
+      next_msg_block(strm);
+    }
+
+    if ((strm->moff == 0) & (ctlen - off >= 16)) {
+      romulus_common::rho(strm->st.arr, txt + off, cipher + off);
+
+      strm->moff = 16;
+      off += 16;
+      continue;
+    }
+
+    const size_t to_read = std::min(16ul - strm->moff, ctlen - off);
+
+    // rho routine works on each byte of state independently
+    for (size_t i = 0; i < to_read; i++) {
+      uint8_t* const s = strm->st.arr + strm->moff + i;
+      const uint8_t gs = ((*s ^ (*s << 7)) & 0x80) | (*s >> 1);
+
+      cipher[off + i] = txt[off + i] ^ gs;
+      *s ^= txt[off + i];
+    }
+
+    strm->moff += to_read;
+    off += to_read;
+  }
+}
+
+// Decrypts N -bytes encrypted text using incremental Romulus-N state | N >= 0,
+// producing N -bytes decrypted text, which can be called any number of times.
+//
+// Note, decrypted text must not be used, before `verify` returns truth value.
+inline static void decrypt_update(
+    stream_t* const __restrict strm,         // Romulus-N stream
+    const uint8_t* const __restrict cipher,  // N -bytes encrypted text
+    uint8_t* const __restrict txt,           // N -bytes decrypted text
+    const size_t ctlen                       // len(cipher) = len(txt) | >= 0
+) {
+  if (!strm->ad_done) {
+    finish_ad(strm);
+  }
+
+  size_t off = 0;
+
+  while (off < ctlen) {
+    if (strm->moff == 16) {
+      next_msg_block(strm);
+    }
+
+    if ((strm->moff == 0) & (ctlen - off >= 16)) {
+      romulus_common::rho_inv(strm->st.arr, cipher + off, txt + off);
+
+      strm->moff = 16;
+      off += 16;
+      continue;
+    }
+
+    const size_t to_read = std::min(16ul - strm->moff, ctlen - off);
+
+    // rho_inv routine works on each byte of state independently
+    for (size_t i = 0; i < to_read; i++) {
+      uint8_t* const s = strm->st.arr + strm->moff + i;
+      const uint8_t gs = ((*s ^ (*s << 7)) & 0x80) | (*s >> 1);
+
+      txt[off + i] = cipher[off + i] ^ gs;
+      *s ^= txt[off + i];
+    }
+
+    strm->moff += to_read;
+    off += to_read;
+  }
+}
+
+// Finishes processing of message, using incremental Romulus-N state, computing
+// 16 -bytes authentication tag. Stream must be initialized again, before being
+// used for another message.
+inline static void finalize(
+    stream_t* const __restrict strm,  // Romulus-N stream
+    uint8_t* const __restrict tag     // 128 -bit authentication tag
+) {
+  if (!strm->ad_done) {
+    finish_ad(strm);
+  }
+
+  // last block is padded, unless it's a full block
+  const bool flg = strm->moff < 16;
+  strm->st.arr[15] ^= static_cast<uint8_t>(strm->moff * flg);
+
+  romulus_common::update_lfsr(strm->lfsr);
+
+  constexpr uint8_t br[2] = {20, 21};
+  romulus_common::encode(strm->lfsr, br[flg], strm->st.arr + 16);
+
+  skinny_simd::tbc(&strm->st, &strm->ts);
+
+  uint8_t tmp[16];
+  std::memset(tmp, 0, 16);
+
+  romulus_common::rho(strm->st.arr, tmp, tag);
+}
+
+// Finishes processing of message, using incremental Romulus-N state, returning
+// truth value, only if computed authentication tag matches expected one
+inline static bool verify(
+    stream_t* const __restrict strm,     // Romulus-N stream
+    const uint8_t* const __restrict tag  // 128 -bit authentication tag
+) {
+  uint8_t tag_[16];
+  finalize(strm, tag_);
+
+  bool flg = false;
+  for (size_t i = 0; i < 16; i++) {
+    flg |= static_cast<bool>(tag[i] ^ tag_[i]);
+  }
+
+  return !flg;
+}
+
+// Descriptor of a single message, to be encrypted/ decrypted as part of a batch
+// of messages, all under same secret key
+//
+// When encrypting, `src` is plain text, `dst` is encrypted text and `tag` is
+// computed, while when decrypting, `src` is encrypted text, `dst` is decrypted
+// text and `tag` is only read.
+struct message_t {
+  const uint8_t* nonce;  // 128 -bit public message nonce
+  const uint8_t* data;   // N -bytes associated data
+  size_t dlen;           // len(data) | >= 0
+  const uint8_t* src;    // M -bytes input text
+  uint8_t* dst;          // M -bytes output text
+  size_t len;            // len(src) = len(dst) | >= 0
+  uint8_t* tag;          // 128 -bit authentication tag
+};
+
+// Number of messages processed in lockstep by `{encrypt, decrypt}_batch`, such
+// that TBC calls of all of them fill all lanes of widest bitsliced
+// Skinny-128-384+ routine
+constexpr size_t BATCH_LANES = skinny_bitsliced::LANES<uint64_t>;
+
+// Progress of a single message, being processed in a lane of batch, where each
+// step prepares input of next TBC call of Romulus-N
+struct batch_lane_t {
+  size_t idx;       // index of message being processed in this lane
+  size_t off;       // offset of next unprocessed byte of associated data/ text
+  uint8_t lfsr[7];  // 56 -bit LFSR counter
+  bool ad_done;     // all associated data bytes are absorbed
+  bool ad_pair;     // last TBC call absorbed a pair of associated data blocks
+};
+
+// Prepares internal state and tweakey state (1, 2) of given lane, for next TBC
+// call of Romulus-N encryption ( or decryption, when `decrypt` is truth
+// value ), following algorithm in figure 2.5 of Romulus specification. Returns
+// truth value, if next TBC call computes final state, from which tag is
+// derived.
+inline static bool prepare_lane(
+    batch_lane_t* const __restrict l,      // lane being processed
+    skinny::state_t* const __restrict st,  // TBC state of lane
+    const message_t* const __restrict m,   // message being processed
+    const bool decrypt                     // encrypting or decrypting ?
+) {
+  uint8_t enc[16];
+  uint8_t blk[16];
+
+  l->ad_pair = false;
+
+  if (!l->ad_done) {
+    const size_t rm = m->dlen - l->off;
+
+    if (rm > 16) {
+      const size_t to_read = std::min(16ul, rm - 16);
+
+      std::memset(blk, 0, 16);
+      std::memcpy(blk, m->data + l->off + 16, to_read);
+
+      const uint8_t br[2] = {blk[15], static_cast<uint8_t>(to_read)};
+      blk[15] = br[to_read < 16];
+
+      romulus_common::rho(st->arr, m->data + l->off, enc);
+      romulus_common::update_lfsr(l->lfsr);
+      romulus_common::encode(blk, l->lfsr, 8, st->arr + 16);
+
+      l->off += 16 + to_read;
+      l->ad_pair = true;
+      return false;
+    }
+
+    if ((rm > 0) | (m->dlen == 0)) {
+      std::memset(blk, 0, 16);
+      std::memcpy(blk, m->data + l->off, rm);
+
+      const uint8_t br[2] = {blk[15], static_cast<uint8_t>(rm)};
+      blk[15] = br[rm < 16];
+
+      romulus_common::rho(st->arr, blk, enc);
+      romulus_common::update_lfsr(l->lfsr);
+    }
+
+    const bool flg = (m->dlen == 0) | ((m->dlen & 15) > 0);
+
+    constexpr uint8_t br[2] = {24, 26};
+    romulus_common::encode(m->nonce, l->lfsr, br[flg], st->arr + 16);
+
+    l->off = 0;
+    l->ad_done = true;
+    return false;
+  }
+
+  if (l->off == 0) {
+    romulus_common::set_lfsr(l->lfsr);
+  }
+
+  const size_t rm = m->len - l->off;
+
+  if (rm > 16) {
+    if (decrypt) {
+      romulus_common::rho_inv(st->arr, m->src + l->off, m->dst + l->off);
+    } else {
+      romulus_common::rho(st->arr, m->src + l->off, m->dst + l->off);
+    }
+
+    romulus_common::update_lfsr(l->lfsr);
+    romulus_common::encode(m->nonce, l->lfsr, 4, st->arr + 16);
+
+    l->off += 16;
+    return false;
+  }
+
+  // rho/ rho_inv routine works on each byte of state independently, so only
+  // remaining bytes are processed, followed by padding
+  for (size_t i = 0; i < rm; i++) {
+    uint8_t* const s = st->arr + i;
+    const uint8_t gs = ((*s ^ (*s << 7)) & 0x80) | (*s >> 1);
+
+    const uint8_t in = m->src[l->off + i];
+    const uint8_t out = in ^ gs;
+
+    m->dst[l->off + i] = out;
+    *s ^= decrypt ? out : in;
+  }
+
+  const bool flg = rm < 16;
+  st->arr[15] ^= static_cast<uint8_t>(rm * flg);
+
+  romulus_common::update_lfsr(l->lfsr);
+
+  constexpr uint8_t br[2] = {20, 21};
+  romulus_common::encode(m->nonce, l->lfsr, br[flg], st->arr + 16);
+
+  return true;
+}
+
+// Given Romulus-N context ( holding expanded secret key ) and N -many message
+// descriptors | N >= 0, this routine encrypts ( when `decrypt` is false ) or
+// decrypts each of them, same as `encrypt`/ `decrypt` routines do. For
+// decryption, verification result of each message is written to `verified`
+// and decrypted text of a message is zeroed, if its verification fails.
+//
+// Upto `BATCH_LANES` -many messages are processed in lockstep, where next TBC
+// call of all of them are batched together and handed over to multi-block
+// Skinny-128-384+ routine, using shared key schedule. As soon as a message is
+// completely processed, its lane is refilled with next message.
+inline static void process_batch(
+    const context_t* const __restrict ctx,   // expanded 128 -bit secret key
+    const message_t* const __restrict msgs,  // N -many message descriptors
+    const size_t n,                          // number of messages | >= 0
+    const bool decrypt,                      // encrypting or decrypting ?
+    bool* const __restrict verified          // N -many verification results
+) {
+  batch_lane_t lanes[BATCH_LANES];
+  bool last[BATCH_LANES];
+  skinny::state_t sts[BATCH_LANES];
+
+  size_t active = 0;
+  size_t next = 0;
+
+  while (true) {
+    // refill free lanes with messages, yet to be processed
+    while ((active < BATCH_LANES) & (next < n)) {
+      batch_lane_t* const l = lanes + active;
+
+      std::memset(sts[active].arr, 0, 16);
+      romulus_common::set_lfsr(l->lfsr);
+
+      l->idx = next;
+      l->off = 0;
+      l->ad_done = false;
+
+      active++;
+      next++;
+    }
+
+    if (active == 0) {
+      break;
+    }
+
+    for (size_t i = 0; i < active; i++) {
+      last[i] = prepare_lane(lanes + i, sts + i, msgs + lanes[i].idx, decrypt);
+    }
+
+    skinny_bitsliced::tbc_many(sts, active, &ctx->ks);
+
+    size_t i = 0;
+    while (i < active) {
+      batch_lane_t* const l = lanes + i;
+
+      if (l->ad_pair) {
+        romulus_common::update_lfsr(l->lfsr);
+      }
+
+      if (!last[i]) {
+        i++;
+        continue;
+      }
+
+      const message_t* const m = msgs + l->idx;
+
+      uint8_t tmp[16];
+      std::memset(tmp, 0, 16);
+
+      if (decrypt) {
+        uint8_t tag_[16];
+        romulus_common::rho(sts[i].arr, tmp, tag_);
+
+        bool flg = false;
+        for (size_t j = 0; j < 16; j++) {
+          flg |= static_cast<bool>(m->tag[j] ^ tag_[j]);
+        }
+
+        std::memset(m->dst, 0, flg * m->len);
+        verified[l->idx] = !flg;
+      } else {
+        romulus_common::rho(sts[i].arr, tmp, m->tag);
+      }
+
+      // move last active lane into this one, keeping active lanes contiguous
+      active--;
+      if (i < active) {
+        std::memcpy(lanes + i, lanes + active, sizeof(batch_lane_t));
+        std::memcpy(sts + i, sts + active, sizeof(skinny::state_t));
+        last[i] = last[active];
+      }
+    }
+  }
+}
+
+// Given Romulus-N context ( holding expanded secret key ) and N -many message
+// descriptors | N >= 0, this routine encrypts each of them, computing encrypted
+// text and authentication tag, same as `encrypt` routine does, while making
+// use of multi-block Skinny-128-384+, across messages
+inline static void encrypt_batch(
+    const context_t* const __restrict ctx,   // expanded 128 -bit secret key
+    const message_t* const __restrict msgs,  // N -many message descriptors
+    const size_t n                           // number of messages | >= 0
+) {
+  process_batch(ctx, msgs, n, false, nullptr);
+}
+
+// Given Romulus-N context ( holding expanded secret key ) and N -many message
+// descriptors | N >= 0, this routine decrypts each of them, computing decrypted
+// text and writing verification result of each message to `verified`, same as
+// `decrypt` routine does, while making use of multi-block Skinny-128-384+,
+// across messages. Returns truth value, only if all messages are verified.
+inline static bool decrypt_batch(
+    const context_t* const __restrict ctx,   // expanded 128 -bit secret key
+    const message_t* const __restrict msgs,  // N -many message descriptors
+    const size_t n,                          // number of messages | >= 0
+    bool* const __restrict verified          // N -many verification results
+) {
+  process_batch(ctx, msgs, n, true, verified);
+
+  bool flg = true;
+  for (size_t i = 0; i < n; i++) {
+    flg &= verified[i];
+  }
+
+  return flg;
+}
+
 }  // namespace romulusn
@@ -1,139 +1,175 @@
 #pragma once
 #include <algorithm>
+#include <atomic>
+#include <thread>
 
 #include "common.hpp"
 #include "romulush.hpp"
 #include "skinny.hpp"
+#include "skinny_simd.hpp"
 
 // Romulus-T Authenticated Encryption with Associated Data
 namespace romulust {
 
-// Extract N -th message block ( 256 -bit wide ) from padded message bytes
-// which is to be authenticated i.e.
+// Minimum length of plain text, for which pipelined encryption routine makes
+// use of a second thread, below that cost of spawning a thread outweighs
+// benefit
+constexpr size_t PIPELINE_MIN_LEN = 1ul << 14;
+
+// Keystream generator publishes its progress after every 64 blocks, when
+// requested, see `keystream_xor`
+constexpr size_t PROGRESS_MASK = 63;
+
+// Given 16 -bytes secret key, 16 -bytes public message nonce and M -bytes
+// input text | M >= 0, this routine computes Romulus-T keystream, XORing it
+// with input text, producing M -bytes output text. Same routine is used for
+// encryption and decryption.
 //
-// msg = ipad_256(padded associated data bytes ||
-//                padded cipher text bytes ||
-//                16 -bytes nonce ||
-//                7 -bytes LFSR counter)
+// When `progress` is non-null, number of output bytes which are ready to be
+// consumed is published, with release semantics, as keystream generation goes
+// on, so that another thread can read output, while it's still being produced.
 //
-// Note, block index = N, begins at zero.
-static void get_auth_block(
-    const uint8_t* const __restrict data,    // N -bytes associated data
-    const size_t dlen,                       // len(data) = N | >= 0
-    const uint8_t* const __restrict cipher,  // M -bytes encrypted text
-    const size_t ctlen,                      // len(cipher) = M | >= 0
-    const uint8_t* const __restrict nonce,   // 16 -bytes nonce
-    const uint8_t* const __restrict lfsr,    // 7 -bytes LFSR counter
-    const size_t blk_idx,                    // Index of block to be extracted
-    uint8_t* const __restrict blk            // 32 -bytes extracted block
+// See first part of encryption algorithm defined in figure 2.9 of Romulus
+// specification
+// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/romulus-spec-final.pdf
+static void keystream_xor(
+    const uint8_t* const __restrict key,    // 128 -bit secret key
+    const uint8_t* const __restrict nonce,  // 128 -bit nonce
+    const uint8_t* const __restrict in,     // M -bytes input text
+    uint8_t* const __restrict out,          // M -bytes output text
+    const size_t ctlen,                     // len(in) = len(out) | >= 0
+    std::atomic<size_t>* const progress     // # -of output bytes ready or null
 ) {
-  std::memset(blk, 0, 32);
-
-  const size_t tmp0 = dlen & 15ul;
-  const size_t tmp1 = ctlen & 15ul;
-
-  const size_t tmp2 = 16ul - tmp0;
-  const size_t tmp3 = 16ul - tmp1;
+  if (ctlen == 0ul) {
+    return;
+  }
 
-  const bool flg0 = dlen > 0ul;
-  const bool flg1 = ctlen > 0ul;
+  uint8_t state[16];
+  uint64_t lfsr = 0ul;
+  uint8_t tweakey[48];
+  uint8_t blk[16];
 
-  const size_t padded_dlen = dlen + tmp2 * flg0;
-  const size_t padded_ctlen = ctlen + tmp3 * flg1;
+  skinny::state_t st;
 
-  const size_t tmp4 = padded_dlen + padded_ctlen;
-  const size_t tmp5 = tmp4 + 16ul;
-  const size_t padded_authlen = tmp5 + 7ul;
+  const size_t blk_cnt = ctlen >> 4;
+  const size_t rm_bytes = ctlen & 15ul;
 
-  size_t off = blk_idx << 5;
-  size_t boff = 0ul;
+  const bool flg = rm_bytes > 0ul;
+  const size_t tot_blk_cnt = blk_cnt + 1ul * flg;
 
-  if (off < padded_dlen) {
-    const size_t read = std::min(32ul, dlen - off);
+  std::memset(blk, 0, 16);
 
-    std::memcpy(blk + boff, data + off, read);
+  romulus_common::encode(key, blk, lfsr, 66, tweakey);
 
-    const uint8_t br0[]{blk[15], static_cast<uint8_t>(read)};
-    const uint8_t br1[]{blk[31], static_cast<uint8_t>(read & 15ul)};
+  skinny::initialize(&st, nonce, tweakey);
+  skinny_simd::tbc(&st);
 
-    blk[15] = br0[read < 16ul];
-    blk[31] = br1[(read > 16ul) & (read < 32ul)];
+  std::memcpy(state, st.arr, 16);
 
-    const size_t read_ = std::min(32ul, padded_dlen - off);
+  lfsr = romulus_common::LFSR_INIT;
 
-    off += read_;
-    boff += read_;
-  }
+  size_t off = 0ul;
 
-  const bool flg2 = off >= padded_dlen;
-  const bool flg3 = off < tmp4;
+  for (size_t i = 0; i < tot_blk_cnt - 1ul; i++) {
+    romulus_common::encode(state, blk, lfsr, 64, tweakey);
+    skinny::initialize(&st, nonce, tweakey);
 
-  if ((boff < 32ul) && (flg2 & flg3)) {
-    constexpr size_t br0[]{32ul, 16ul};
+    // keystream block ( domain 64 ) and next state ( domain 65 ) are computed
+    // by encrypting nonce under tweakeys, which differ only in domain byte
+    uint8_t tk1[16];
+    std::memcpy(tk1, tweakey, 16);
+    tk1[7] = 65;
 
-    const size_t ctoff = off - padded_dlen;
-    const size_t read = std::min(br0[boff >= 16ul], ctlen - ctoff);
+    skinny_simd::tbc2_tk1(&st, tk1, state);
 
-    std::memcpy(blk + boff, cipher + ctoff, read);
+    for (size_t j = 0; j < 16; j++) {
+      out[off + j] = in[off + j] ^ st.arr[j];
+    }
 
-    const uint8_t br1[]{blk[15], static_cast<uint8_t>(read)};
-    const uint8_t br2[]{blk[31], static_cast<uint8_t>(read & 15ul)};
+    off += 16ul;
+    lfsr = romulus_common::step_lfsr(lfsr);
 
-    blk[15] = br1[(boff < 16ul) & (read < 16ul)];
-    blk[31] = br2[(boff < 16ul) & (read > 16ul) & (read < 32ul)];
+    if ((progress != nullptr) & ((i & PROGRESS_MASK) == PROGRESS_MASK)) {
+      progress->store(off, std::memory_order_release);
+    }
+  }
 
-    const uint8_t br3[]{blk[31], static_cast<uint8_t>(read)};
+  romulus_common::encode(state, blk, lfsr, 64, tweakey);
 
-    blk[31] = br3[(boff >= 16ul) & (read < 16ul)];
+  skinny::initialize(&st, nonce, tweakey);
+  skinny_simd::tbc(&st);
 
-    const size_t read_ = std::min(32ul, padded_ctlen - ctoff);
+  const size_t read = ctlen - off;
 
-    off += read_;
-    boff += read_;
+  for (size_t i = 0; i < read; i++) {
+    out[off + i] = in[off + i] ^ st.arr[i];
   }
 
-  const bool flg4 = off >= tmp4;
-  const bool flg5 = off < tmp5;
-
-  if ((boff < 32ul) && (flg4 & flg5)) {
-    std::memcpy(blk + boff, nonce, 16);
-
-    off += 16ul;
-    boff += 16ul;
+  if (progress != nullptr) {
+    progress->store(ctlen, std::memory_order_release);
   }
+}
 
-  const bool flg6 = off >= tmp5;
-  const bool flg7 = off < padded_authlen;
+// Associated data hashed by Romulus-H, as part of authentication tag
+// computation, which depends only on associated data, but not on secret key,
+// nonce or cipher text, so that associated data repeated across many messages
+// can be hashed only once, see `absorb`, and each tag computation resumes from
+// it. All 32 -bytes blocks, lying strictly inside associated data, are
+// compressed, while last 1 to 32 bytes are kept, so that they're padded along
+// with rest of the message, see `compute_tag`.
+struct ad_checkpoint_t {
+  uint8_t left[16];   // Romulus-H chaining value, after compressing
+  uint8_t right[16];  // all those 32 -bytes blocks
+  uint8_t tail[32];   // associated data bytes, not yet compressed
+  size_t tlen;        // len(tail) | = 0, only when associated data is empty
+};
+
+// Given N -bytes associated data | N >= 0, this routine computes Romulus-H
+// chaining value after compressing all 32 -bytes blocks lying strictly inside
+// it, which can be used for computing authentication tag of any number of
+// messages, under any key and nonce
+inline static void absorb(
+    ad_checkpoint_t* const __restrict ckpt,  // hashed AD ( computed )
+    const uint8_t* const __restrict data,    // N -bytes associated data
+    const size_t dlen                        // len(data) = N | >= 0
+) {
+  std::memset(ckpt->left, 0, 16);
+  std::memset(ckpt->right, 0, 16);
 
-  if ((boff < 32ul) && (flg6 & flg7)) {
-    std::memcpy(blk + boff, lfsr, 7);
+  const size_t blk_cnt = dlen > 0ul ? (dlen - 1ul) >> 5 : 0ul;
 
-    off += 7ul;
-    boff += 7ul;
+  for (size_t i = 0; i < blk_cnt; i++) {
+    romulush::compress(ckpt->left, ckpt->right, data + (i << 5));
   }
 
-  const uint8_t br[]{blk[31], static_cast<uint8_t>(boff)};
-  blk[31] = br[boff < 32ul];
+  ckpt->tlen = dlen - (blk_cnt << 5);
+  std::memcpy(ckpt->tail, data + (blk_cnt << 5), ckpt->tlen);
 }
 
-// Given 16 -bytes secret key, 16 -bytes public message nonce, N -bytes
-// associated data and M -bytes plain text | N, M >= 0, this routine computes M
-// -bytes encrypted text and 16 -bytes authentication tag, using Romulus-T
-// authenticated encryption algorithm, which is leakage-resistant.
+// Given 16 -bytes secret key, 16 -bytes public message nonce, already hashed
+// associated data and M -bytes encrypted text | M >= 0, this routine computes
+// 16 -bytes authentication tag, by hashing rest of associated data, encrypted
+// text, nonce and LFSR counter, using Romulus-H, followed by encrypting digest.
 //
-// See encryption algorithm defined in figure 2.9 of Romulus specification
+// When `avail` is non-null, encrypted text is still being produced by another
+// thread, which publishes number of bytes ready to be consumed, so hashing of
+// each block waits until all encrypted text bytes it covers are available.
+//
+// See second part of encryption algorithm defined in figure 2.9 of Romulus
+// specification
 // https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/romulus-spec-final.pdf
-static void encrypt(
-    const uint8_t* const __restrict key,    // 128 -bit secret key
-    const uint8_t* const __restrict nonce,  // 128 -bit nonce
-    const uint8_t* const __restrict data,   // N -bytes associated data
-    const size_t dlen,                      // len(data) = N | >= 0
-    const uint8_t* const __restrict text,   // M -bytes plain text
-    uint8_t* const __restrict cipher,       // M -bytes cipher text
-    const size_t ctlen,                     // len(text) = len(cipher) | >= 0
-    uint8_t* const __restrict tag           // 128 -bit authentication tag
+static void compute_tag(
+    const uint8_t* const __restrict key,           // 128 -bit secret key
+    const uint8_t* const __restrict nonce,         // 128 -bit nonce
+    const ad_checkpoint_t* const __restrict ckpt,  // hashed AD
+    const uint8_t* const __restrict cipher,        // M -bytes cipher text
+    const size_t ctlen,                            // len(cipher) = M | >= 0
+    uint8_t* const __restrict tag,                 // 128 -bit tag
+    const std::atomic<size_t>* const avail         // ready cipher bytes or null
 ) {
-  uint8_t state[16];
+  const uint8_t* const data = ckpt->tail;
+  const size_t dlen = ckpt->tlen;
+
   uint8_t lfsr[7];
   uint8_t tweakey[48];
 
@@ -145,109 +181,149 @@ static void encrypt(
   const bool flg = rm_bytes > 0ul;
   const size_t tot_blk_cnt = blk_cnt + 1ul * flg;
 
-  if (ctlen > 0ul) {
-    uint8_t blk[16];
-
-    std::memset(blk, 0, 16);
-    std::memset(lfsr, 0, 7);
-
-    romulus_common::encode(key, blk, lfsr, 66, tweakey);
-
-    skinny::initialize(&st, nonce, tweakey);
-    skinny::tbc(&st);
+  // LFSR counter, after as many updations as there are cipher text blocks, is
+  // computed directly, instead of stepping through all of them
+  const uint64_t ctr = romulus_common::jump_lfsr(romulus_common::LFSR_INIT,
+                                                 tot_blk_cnt);
+  romulus_common::store_lfsr(ctr, lfsr);
 
-    std::memcpy(state, st.arr, 16);
+  uint8_t left[16]{};
+  uint8_t right[16]{};
+  uint8_t blk[32]{};
 
-    romulus_common::set_lfsr(lfsr);
+  std::memcpy(left, ckpt->left, sizeof(left));
+  std::memcpy(right, ckpt->right, sizeof(right));
 
-    size_t off = 0ul;
+  const size_t tmp0 = dlen & 15ul;
+  const size_t tmp1 = ctlen & 15ul;
 
-    for (size_t i = 0; i < tot_blk_cnt - 1ul; i++) {
-      romulus_common::encode(state, blk, lfsr, 64, tweakey);
+  const size_t tmp2 = 16ul - tmp0;
+  const size_t tmp3 = 16ul - tmp1;
 
-      skinny::initialize(&st, nonce, tweakey);
-      skinny::tbc(&st);
+  const bool flg0 = dlen > 0ul;
+  const bool flg1 = ctlen > 0ul;
 
-      for (size_t j = 0; j < 16; j++) {
-        cipher[off + j] = text[off + j] ^ st.arr[j];
-      }
+  const size_t padded_dlen = dlen + tmp2 * flg0;
+  const size_t padded_ctlen = ctlen + tmp3 * flg1;
+  const size_t padded_authlen = padded_dlen + padded_ctlen + 16ul + 7ul;
 
-      romulus_common::encode(state, blk, lfsr, 65, tweakey);
+  const size_t padded_blk_cnt = padded_authlen >> 5;
+  const size_t padded_rm_bytes = padded_authlen & 31ul;
 
-      skinny::initialize(&st, nonce, tweakey);
-      skinny::tbc(&st);
+  const bool flg2 = padded_rm_bytes > 0ul;
+  const size_t tot_padded_blk_cnt = padded_blk_cnt + 1ul * flg2;
 
-      std::memcpy(state, st.arr, 16);
+  // # -of 16 -bytes blocks of padded associated data and padded cipher text,
+  // which are followed by nonce and LFSR counter
+  const size_t msg_cnt = (padded_dlen + padded_ctlen) >> 4;
 
-      off += 16ul;
-      romulus_common::update_lfsr(lfsr);
+  // waits until encrypted text bytes, covered by i -th block, are available
+  auto wait_for = [&](const size_t blk_idx) {
+    if (avail == nullptr) {
+      return;
     }
 
-    romulus_common::encode(state, blk, lfsr, 64, tweakey);
+    const size_t end = (blk_idx + 1ul) << 5;
+    const size_t need = std::min(end - std::min(end, padded_dlen), ctlen);
 
-    skinny::initialize(&st, nonce, tweakey);
-    skinny::tbc(&st);
-
-    const size_t read = ctlen - off;
+    while (avail->load(std::memory_order_acquire) < need) {
+      std::this_thread::yield();
+    }
+  };
+
+  // message to be hashed i.e. ipad_256(padded associated data || padded
+  // cipher text || nonce || LFSR counter), is walked in single forward pass,
+  // where 256 -bit blocks, made of two full blocks of same input, are read in
+  // place, while others are assembled in `blk`
+  romulus_common::blocks_t it;
+  romulus_common::init_blocks(&it, data, dlen, cipher, ctlen,
+                              romulus_common::pad_t::romulust);
+
+  for (size_t i = 0; i < tot_padded_blk_cnt; i++) {
+    wait_for(i);
+
+    const uint8_t* msg = blk;
+
+    if (romulus_common::full_blocks(&it) >= 2) {
+      msg = romulus_common::take_blocks(&it, 2);
+    } else {
+      std::memset(blk, 0, 32);
+
+      size_t boff = 0;
+
+      for (size_t j = (i << 1); j < (i << 1) + 2; j++) {
+        if (j < msg_cnt) {
+          std::memcpy(blk + boff, romulus_common::next_block(&it), 16);
+          boff += 16;
+        } else if (j == msg_cnt) {
+          std::memcpy(blk + boff, nonce, 16);
+          boff += 16;
+        } else if (j == msg_cnt + 1) {
+          std::memcpy(blk + boff, lfsr, 7);
+          boff += 7;
+        }
+      }
 
-    for (size_t i = 0; i < read; i++) {
-      cipher[off + i] = text[off + i] ^ st.arr[i];
+      const uint8_t br[]{blk[31], static_cast<uint8_t>(boff)};
+      blk[31] = br[boff < 32ul];
     }
-  }
 
-  romulus_common::set_lfsr(lfsr);
+    if (i == tot_padded_blk_cnt - 1ul) {
+      left[0] ^= 0b00000010;
+    }
 
-  for (size_t i = 0; i < tot_blk_cnt; i++) {
-    romulus_common::update_lfsr(lfsr);
+    romulush::compress(left, right, msg);
   }
 
-  {
-    uint8_t left[16]{};
-    uint8_t right[16]{};
-    uint8_t blk[32]{};
-
-    std::memset(left, 0, sizeof(left));
-    std::memset(right, 0, sizeof(right));
-
-    const size_t tmp0 = dlen & 15ul;
-    const size_t tmp1 = ctlen & 15ul;
-
-    const size_t tmp2 = 16ul - tmp0;
-    const size_t tmp3 = 16ul - tmp1;
-
-    const bool flg0 = dlen > 0ul;
-    const bool flg1 = ctlen > 0ul;
-
-    const size_t padded_dlen = dlen + tmp2 * flg0;
-    const size_t padded_ctlen = ctlen + tmp3 * flg1;
-    const size_t padded_authlen = padded_dlen + padded_ctlen + 16ul + 7ul;
-
-    const size_t padded_blk_cnt = padded_authlen >> 5;
-    const size_t padded_rm_bytes = padded_authlen & 31ul;
-
-    const bool flg2 = padded_rm_bytes > 0ul;
-    const size_t tot_padded_blk_cnt = padded_blk_cnt + 1ul * flg2;
-
-    for (size_t i = 0; i < tot_padded_blk_cnt - 1ul; i++) {
-      get_auth_block(data, dlen, cipher, ctlen, nonce, lfsr, i, blk);
-      romulush::compress(left, right, blk);
-    }
+  std::memset(lfsr, 0, 7);
 
-    left[0] ^= 0b00000010;
+  romulus_common::encode(key, right, lfsr, 68, tweakey);
+  skinny::initialize(&st, left, tweakey);
+  skinny_simd::tbc(&st);
 
-    const size_t id = tot_padded_blk_cnt - 1ul;
-
-    get_auth_block(data, dlen, cipher, ctlen, nonce, lfsr, id, blk);
-    romulush::compress(left, right, blk);
+  std::memcpy(tag, st.arr, 16);
+}
 
-    std::memset(lfsr, 0, 7);
+// Given 16 -bytes secret key, 16 -bytes public message nonce, N -bytes
+// associated data and M -bytes encrypted text | N, M >= 0, this routine
+// computes 16 -bytes authentication tag, by hashing associated data, encrypted
+// text, nonce and LFSR counter, using Romulus-H, followed by encrypting digest,
+// see above
+static void compute_tag(
+    const uint8_t* const __restrict key,     // 128 -bit secret key
+    const uint8_t* const __restrict nonce,   // 128 -bit nonce
+    const uint8_t* const __restrict data,    // N -bytes associated data
+    const size_t dlen,                       // len(data) = N | >= 0
+    const uint8_t* const __restrict cipher,  // M -bytes cipher text
+    const size_t ctlen,                      // len(cipher) = M | >= 0
+    uint8_t* const __restrict tag,           // 128 -bit authentication tag
+    const std::atomic<size_t>* const avail   // # -of cipher bytes ready or null
+) {
+  ad_checkpoint_t ckpt;
+  absorb(&ckpt, data, dlen);
 
-    romulus_common::encode(key, right, lfsr, 68, tweakey);
-    skinny::initialize(&st, left, tweakey);
-    skinny::tbc(&st);
+  compute_tag(key, nonce, &ckpt, cipher, ctlen, tag, avail);
+}
 
-    std::memcpy(tag, st.arr, 16);
-  }
+// Given 16 -bytes secret key, 16 -bytes public message nonce, N -bytes
+// associated data and M -bytes plain text | N, M >= 0, this routine computes M
+// -bytes encrypted text and 16 -bytes authentication tag, using Romulus-T
+// authenticated encryption algorithm, which is leakage-resistant.
+//
+// See encryption algorithm defined in figure 2.9 of Romulus specification
+// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/romulus-spec-final.pdf
+static void encrypt(
+    const uint8_t* const __restrict key,    // 128 -bit secret key
+    const uint8_t* const __restrict nonce,  // 128 -bit nonce
+    const uint8_t* const __restrict data,   // N -bytes associated data
+    const size_t dlen,                      // len(data) = N | >= 0
+    const uint8_t* const __restrict text,   // M -bytes plain text
+    uint8_t* const __restrict cipher,       // M -bytes cipher text
+    const size_t ctlen,                     // len(text) = len(cipher) | >= 0
+    uint8_t* const __restrict tag           // 128 -bit authentication tag
+) {
+  keystream_xor(key, nonce, text, cipher, ctlen, nullptr);
+  compute_tag(key, nonce, data, dlen, cipher, ctlen, tag, nullptr);
 }
 
 // Given 16 -bytes secret key, 16 -bytes public message nonce, 16 -bytes
@@ -264,130 +340,96 @@ static bool decrypt(const uint8_t* const __restrict key,
                     const uint8_t* const __restrict data, const size_t dlen,
                     const uint8_t* const __restrict cipher,
                     uint8_t* const __restrict text, const size_t ctlen) {
-  uint8_t state[16];
   uint8_t tag_[16];
-  uint8_t lfsr[7];
-  uint8_t tweakey[48];
 
-  skinny::state_t st;
+  compute_tag(key, nonce, data, dlen, cipher, ctlen, tag_, nullptr);
 
-  const size_t blk_cnt = ctlen >> 4;
-  const size_t rm_bytes = ctlen & 15ul;
+  bool flg = false;
 
-  const bool flg0 = rm_bytes > 0ul;
-  const size_t tot_blk_cnt = blk_cnt + 1ul * flg0;
-
-  romulus_common::set_lfsr(lfsr);
-
-  for (size_t i = 0; i < tot_blk_cnt; i++) {
-    romulus_common::update_lfsr(lfsr);
+  for (size_t i = 0; i < 16; i++) {
+    flg |= static_cast<bool>(tag[i] ^ tag_[i]);
   }
 
-  {
-    uint8_t left[16]{};
-    uint8_t right[16]{};
-    uint8_t blk[32]{};
-
-    std::memset(left, 0, sizeof(left));
-    std::memset(right, 0, sizeof(right));
-
-    const size_t tmp0 = dlen & 15ul;
-    const size_t tmp1 = ctlen & 15ul;
-
-    const size_t tmp2 = 16ul - tmp0;
-    const size_t tmp3 = 16ul - tmp1;
-
-    const bool flg0 = dlen > 0ul;
-    const bool flg1 = ctlen > 0ul;
-
-    const size_t padded_dlen = dlen + tmp2 * flg0;
-    const size_t padded_ctlen = ctlen + tmp3 * flg1;
-    const size_t padded_authlen = padded_dlen + padded_ctlen + 16ul + 7ul;
-
-    const size_t padded_blk_cnt = padded_authlen >> 5;
-    const size_t padded_rm_bytes = padded_authlen & 31ul;
-
-    const bool flg2 = padded_rm_bytes > 0ul;
-    const size_t tot_padded_blk_cnt = padded_blk_cnt + 1ul * flg2;
-
-    for (size_t i = 0; i < tot_padded_blk_cnt - 1ul; i++) {
-      get_auth_block(data, dlen, cipher, ctlen, nonce, lfsr, i, blk);
-      romulush::compress(left, right, blk);
-    }
-
-    left[0] ^= 0b00000010;
-
-    const size_t id = tot_padded_blk_cnt - 1ul;
+  if (!flg) {
+    keystream_xor(key, nonce, cipher, text, ctlen, nullptr);
+  }
 
-    get_auth_block(data, dlen, cipher, ctlen, nonce, lfsr, id, blk);
-    romulush::compress(left, right, blk);
+  return !flg;
+}
 
-    std::memset(lfsr, 0, 7);
+// Same as `encrypt` routine, except associated data is already hashed, see
+// `absorb`, so that associated data shared by many messages, encrypted under
+// same or different key, is hashed only once. Output is same as `encrypt`
+// routine, invoked with associated data, which is used for computing `ckpt`.
+inline static void encrypt(
+    const uint8_t* const __restrict key,           // 128 -bit secret key
+    const ad_checkpoint_t* const __restrict ckpt,  // hashed AD
+    const uint8_t* const __restrict nonce,         // 128 -bit nonce
+    const uint8_t* const __restrict text,          // M -bytes plain text
+    uint8_t* const __restrict cipher,              // M -bytes cipher text
+    const size_t ctlen,                            // len(text) = M | >= 0
+    uint8_t* const __restrict tag                  // 128 -bit tag
+) {
+  keystream_xor(key, nonce, text, cipher, ctlen, nullptr);
+  compute_tag(key, nonce, ckpt, cipher, ctlen, tag, nullptr);
+}
 
-    romulus_common::encode(key, right, lfsr, 68, tweakey);
-    skinny::initialize(&st, left, tweakey);
-    skinny::tbc(&st);
+// Same as `decrypt` routine, except associated data is already hashed, see
+// `absorb`. Output is same as `decrypt` routine, invoked with associated data,
+// which is used for computing `ckpt`.
+inline static bool decrypt(
+    const uint8_t* const __restrict key,           // 128 -bit secret key
+    const ad_checkpoint_t* const __restrict ckpt,  // hashed AD
+    const uint8_t* const __restrict nonce,         // 128 -bit nonce
+    const uint8_t* const __restrict tag,           // 128 -bit tag
+    const uint8_t* const __restrict cipher,        // M -bytes cipher text
+    uint8_t* const __restrict text,                // M -bytes plain text
+    const size_t ctlen                             // len(cipher) = M | >= 0
+) {
+  uint8_t tag_[16];
 
-    std::memcpy(tag_, st.arr, 16);
-  }
+  compute_tag(key, nonce, ckpt, cipher, ctlen, tag_, nullptr);
 
-  bool flg1 = false;
+  bool flg = false;
 
   for (size_t i = 0; i < 16; i++) {
-    flg1 |= static_cast<bool>(tag[i] ^ tag_[i]);
+    flg |= static_cast<bool>(tag[i] ^ tag_[i]);
   }
 
-  if (!flg1 & (ctlen > 0ul)) {
-    uint8_t blk[16];
-
-    std::memset(blk, 0, 16);
-    std::memset(lfsr, 0, 7);
-
-    romulus_common::encode(key, blk, lfsr, 66, tweakey);
-
-    skinny::initialize(&st, nonce, tweakey);
-    skinny::tbc(&st);
-
-    std::memcpy(state, st.arr, 16);
-
-    romulus_common::set_lfsr(lfsr);
-
-    size_t off = 0ul;
-
-    for (size_t i = 0; i < tot_blk_cnt - 1ul; i++) {
-      romulus_common::encode(state, blk, lfsr, 64, tweakey);
-
-      skinny::initialize(&st, nonce, tweakey);
-      skinny::tbc(&st);
-
-      for (size_t j = 0; j < 16; j++) {
-        text[off + j] = cipher[off + j] ^ st.arr[j];
-      }
-
-      romulus_common::encode(state, blk, lfsr, 65, tweakey);
-
-      skinny::initialize(&st, nonce, tweakey);
-      skinny::tbc(&st);
-
-      std::memcpy(state, st.arr, 16);
+  if (!flg) {
+    keystream_xor(key, nonce, cipher, text, ctlen, nullptr);
+  }
 
-      off += 16ul;
-      romulus_common::update_lfsr(lfsr);
-    }
+  return !flg;
+}
 
-    romulus_common::encode(state, blk, lfsr, 64, tweakey);
+// Same as `encrypt` routine, except, for long enough plain text, keystream is
+// generated on a second thread, while this thread hashes encrypted text blocks,
+// as soon as they are produced, so that latency approaches maximum of both
+// phases, instead of their sum. Output is same as `encrypt` routine.
+inline static void encrypt_pipelined(
+    const uint8_t* const __restrict key,    // 128 -bit secret key
+    const uint8_t* const __restrict nonce,  // 128 -bit nonce
+    const uint8_t* const __restrict data,   // N -bytes associated data
+    const size_t dlen,                      // len(data) = N | >= 0
+    const uint8_t* const __restrict text,   // M -bytes plain text
+    uint8_t* const __restrict cipher,       // M -bytes cipher text
+    const size_t ctlen,                     // len(text) = len(cipher) | >= 0
+    uint8_t* const __restrict tag           // 128 -bit authentication tag
+) {
+  if (ctlen < PIPELINE_MIN_LEN) {
+    encrypt(key, nonce, data, dlen, text, cipher, ctlen, tag);
+    return;
+  }
 
-    skinny::initialize(&st, nonce, tweakey);
-    skinny::tbc(&st);
+  std::atomic<size_t> produced{0ul};
 
-    const size_t read = ctlen - off;
+  std::thread producer(
+      [&]() { keystream_xor(key, nonce, text, cipher, ctlen, &produced); });
 
-    for (size_t i = 0; i < read; i++) {
-      text[off + i] = cipher[off + i] ^ st.arr[i];
-    }
-  }
+  compute_tag(key, nonce, data, dlen, cipher, ctlen, tag, &produced);
 
-  return !flg1;
+  producer.join();
 }
 
 }  // namespace romulust
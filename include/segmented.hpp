@@ -0,0 +1,415 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "romulusm.hpp"
+#include "romulusn.hpp"
+#include "romulust.hpp"
+
+// Segmented ( STREAM-style ) container mode on top of Romulus-{N, M, T}, where
+// plain text is split into fixed size segments, each of them encrypted and
+// authenticated independently, under a nonce made of 11 -bytes message nonce,
+// 32 -bit segment index and a flag denoting whether it's last segment. So any
+// range of cipher text can be decrypted and verified, by only touching
+// segments covering it, while segments can be processed in any order, on many
+// threads.
+//
+// Sealed message is concatenation of sealed segments, where each sealed segment
+// is encrypted segment followed by its 16 -bytes authentication tag. All
+// segments carry `seg_len` -bytes of plain text, except last one, which carries
+// remaining ( non-zero, unless plain text is empty ) bytes.
+//
+// See STREAM construction in section 7 of https://eprint.iacr.org/2015/189.pdf
+namespace romulus_segmented {
+
+// Romulus AEAD schemes, on top of which segmented container mode can be used
+enum class aead_t { romulusn, romulusm, romulust };
+
+// Byte length of message nonce, which takes first 11 -bytes of each segment
+// nonce, while remaining 5 -bytes carry segment index and last segment flag
+constexpr size_t NONCE_LEN = 11;
+
+// Segment index is encoded as 32 -bit integer, so a message can't be split
+// into more segments than this
+constexpr size_t MAX_SEGMENTS = 1ul << 32;
+
+// Secret key, prepared once, such that key expansion isn't repeated for each
+// segment, when Romulus-N is being used
+struct context_t {
+  aead_t aead;
+  uint8_t key[16];
+  romulusn::context_t ctx;
+};
+
+// Prepares secret key for being used with chosen Romulus AEAD scheme
+inline static void setup(context_t* const __restrict k,
+                         const aead_t aead,
+                         const uint8_t* const __restrict key) {
+  k->aead = aead;
+  std::memcpy(k->key, key, 16);
+
+  if (aead == aead_t::romulusn) {
+    romulusn::setup(&k->ctx, key);
+  }
+}
+
+// Number of segments, given M -bytes plain text is split into | M >= 0, where
+// empty plain text still makes a single ( empty ) segment, while it's 0, when
+// `seg_len` is 0, as plain text can't be split into empty segments
+inline static size_t segment_count(const size_t ctlen, const size_t seg_len) {
+  if (seg_len == 0) {
+    return 0;
+  }
+  return std::max<size_t>(1, ctlen / seg_len + (ctlen % seg_len > 0));
+}
+
+// Length of sealed message, given M -bytes plain text | M >= 0
+inline static size_t sealed_len(const size_t ctlen, const size_t seg_len) {
+  return ctlen + (segment_count(ctlen, seg_len) << 4);
+}
+
+// Given length of sealed message, computes length of plain text, returning
+// false, if `seg_len` is 0, no plain text can be sealed into message of that
+// length, or it'd need more than `MAX_SEGMENTS` segments
+inline static bool plain_len(const size_t slen,
+                             const size_t seg_len,
+                             size_t* const ctlen) {
+  if (seg_len == 0) {
+    return false;
+  }
+
+  // when sealed segment length doesn't fit in size_t, message is shorter than
+  // a sealed segment
+  const size_t step = seg_len + 16;
+  const bool wraps = step < seg_len;
+
+  const size_t full = wraps ? 0ul : slen / step;
+  const size_t rm = wraps ? slen : slen % step;
+
+  // last segment, unless it's only one, carries at least a byte
+  const bool partial = (rm > 0) & (rm < 16 + (full > 0));
+
+  if ((slen < 16) | partial) {
+    return false;
+  }
+
+  if (full + (rm > 0) > MAX_SEGMENTS) {
+    return false;
+  }
+
+  *ctlen = slen - ((full + (rm > 0)) << 4);
+  return true;
+}
+
+// Derives nonce of i -th segment, as 11 -bytes message nonce || 32 -bit big
+// endian segment index || last segment flag byte, where each of them occupies
+// its own bytes, so that distinct ( nonce, index, flag ) triples never derive
+// same segment nonce, while segments can neither be reordered nor truncated
+inline static void derive_nonce(
+    const uint8_t* const __restrict nonce,  // 11 -bytes message nonce
+    const uint32_t seg_idx,                 // index of segment
+    const bool last,                        // is it last segment ?
+    uint8_t* const __restrict seg_nonce     // 16 -bytes segment nonce
+) {
+  std::memcpy(seg_nonce, nonce, NONCE_LEN);
+
+  for (size_t i = 0; i < 4; i++) {
+    seg_nonce[NONCE_LEN + i] = static_cast<uint8_t>(seg_idx >> ((3 - i) << 3));
+  }
+
+  seg_nonce[15] = static_cast<uint8_t>(last);
+}
+
+// Encrypts i -th segment, carrying M -bytes plain text, writing M -bytes
+// encrypted text followed by 16 -bytes authentication tag to `sealed`, where
+// associated data is authenticated along with each segment
+inline static void seal_segment(
+    const context_t* const __restrict k,    // prepared secret key
+    const uint8_t* const __restrict nonce,  // 11 -bytes message nonce
+    const size_t seg_idx,                   // < MAX_SEGMENTS
+    const bool last,                        // is it last segment ?
+    const uint8_t* const __restrict data,   // N -bytes associated data
+    const size_t dlen,                      // len(data) = N | >= 0
+    const uint8_t* const __restrict text,   // M -bytes plain text
+    const size_t ctlen,                     // len(text) = M | >= 0
+    uint8_t* const __restrict sealed        // M + 16 -bytes sealed segment
+) {
+  uint8_t seg_nonce[16];
+  derive_nonce(nonce, static_cast<uint32_t>(seg_idx), last, seg_nonce);
+
+  switch (k->aead) {
+    case aead_t::romulusn:
+      romulusn::encrypt(&k->ctx, seg_nonce, data, dlen, text, sealed, ctlen,
+                        sealed + ctlen);
+      return;
+    case aead_t::romulusm:
+      romulusm::encrypt(k->key, seg_nonce, data, dlen, text, sealed, ctlen,
+                        sealed + ctlen);
+      return;
+    case aead_t::romulust:
+      romulust::encrypt(k->key, seg_nonce, data, dlen, text, sealed, ctlen,
+                        sealed + ctlen);
+      return;
+  }
+}
+
+// Decrypts and verifies i -th sealed segment, carrying M -bytes encrypted text
+// followed by 16 -bytes authentication tag, writing M -bytes plain text, which
+// must not be consumed, if verification fails
+inline static bool open_segment(
+    const context_t* const __restrict k,     // prepared secret key
+    const uint8_t* const __restrict nonce,   // 11 -bytes message nonce
+    const size_t seg_idx,                    // < MAX_SEGMENTS
+    const bool last,                         // is it last segment ?
+    const uint8_t* const __restrict data,    // N -bytes associated data
+    const size_t dlen,                       // len(data) = N | >= 0
+    const uint8_t* const __restrict sealed,  // M + 16 -bytes sealed segment
+    uint8_t* const __restrict text,          // M -bytes plain text
+    const size_t ctlen                       // len(text) = M | >= 0
+) {
+  uint8_t seg_nonce[16];
+  derive_nonce(nonce, static_cast<uint32_t>(seg_idx), last, seg_nonce);
+
+  switch (k->aead) {
+    case aead_t::romulusn:
+      return romulusn::decrypt(&k->ctx, seg_nonce, sealed + ctlen, data, dlen,
+                               sealed, text, ctlen);
+    case aead_t::romulusm:
+      return romulusm::decrypt(k->key, seg_nonce, sealed + ctlen, data, dlen,
+                               sealed, text, ctlen);
+    case aead_t::romulust:
+      return romulust::decrypt(k->key, seg_nonce, sealed + ctlen, data, dlen,
+                               sealed, text, ctlen);
+  }
+  return false;
+}
+
+// Given prepared secret key, 11 -bytes message nonce, N -bytes associated data
+// and M -bytes plain text | N, M >= 0, this routine splits plain text into
+// `seg_len` -bytes segments | seg_len > 0, sealing each of them, writing
+// sealed_len(M, seg_len) -bytes sealed message, returning false, without
+// writing anything, if `seg_len` is 0 or plain text would need more than
+// `MAX_SEGMENTS` segments
+inline static bool seal(
+    const context_t* const __restrict k,    // prepared secret key
+    const uint8_t* const __restrict nonce,  // 11 -bytes message nonce
+    const uint8_t* const __restrict data,   // N -bytes associated data
+    const size_t dlen,                      // len(data) = N | >= 0
+    const uint8_t* const __restrict text,   // M -bytes plain text
+    const size_t ctlen,                     // len(text) = M | >= 0
+    const size_t seg_len,                   // plain text bytes per segment
+    uint8_t* const __restrict sealed        // sealed message
+) {
+  const size_t cnt = segment_count(ctlen, seg_len);
+
+  if ((cnt == 0) || (cnt > MAX_SEGMENTS)) {
+    return false;
+  }
+
+  for (size_t i = 0; i < cnt; i++) {
+    const size_t off = i * seg_len;
+    const size_t len = std::min(seg_len, ctlen - off);
+
+    seal_segment(k, nonce, i, i == cnt - 1, data, dlen, text + off, len,
+                 sealed + off + (i << 4));
+  }
+
+  return true;
+}
+
+// Given prepared secret key, 11 -bytes message nonce, N -bytes associated data
+// and sealed message, this routine decrypts and verifies plain text bytes in
+// range [off, off + len), by only touching segments covering that range,
+// returning false, if `seg_len` is 0, sealed message is malformed, range is out
+// of bounds or any of covering segments fails verification, in which case
+// output is zeroed
+inline static bool open_range(
+    const context_t* const __restrict k,     // prepared secret key
+    const uint8_t* const __restrict nonce,   // 11 -bytes message nonce
+    const uint8_t* const __restrict data,    // N -bytes associated data
+    const size_t dlen,                       // len(data) = N | >= 0
+    const uint8_t* const __restrict sealed,  // sealed message
+    const size_t slen,                       // len(sealed)
+    const size_t seg_len,                    // plain text bytes per segment
+    const size_t off,                        // offset of first plain text byte
+    uint8_t* const __restrict text,          // decrypted plain text bytes
+    const size_t len                         // len(text)
+) {
+  size_t ctlen = 0;
+
+  const bool valid = plain_len(slen, seg_len, &ctlen);
+  if (!valid || (off > ctlen) || (len > ctlen - off)) {
+    std::memset(text, 0, len);
+    return false;
+  }
+
+  const size_t cnt = segment_count(ctlen, seg_len);
+  const size_t first = off / seg_len;
+  const size_t last = len > 0 ? (off + len - 1) / seg_len : first;
+
+  // when plain text is empty, its only segment is still verified
+  const size_t end = std::min(last + 1, cnt);
+
+  std::vector<uint8_t> tmp;
+  bool flg = true;
+
+  for (size_t i = first; i < end; i++) {
+    const size_t soff = i * seg_len;
+    const size_t seg_ctlen = std::min(seg_len, ctlen - soff);
+
+    const size_t beg = std::max(off, soff);
+    const size_t fin = std::min(off + len, soff + seg_ctlen);
+
+    const uint8_t* const seg = sealed + soff + (i << 4);
+    const bool full = (beg == soff) & (fin == soff + seg_ctlen);
+
+    if (full) {
+      flg &= open_segment(k, nonce, i, i == cnt - 1, data, dlen, seg,
+                          text + (beg - off), seg_ctlen);
+    } else {
+      tmp.resize(seg_ctlen);
+      flg &= open_segment(k, nonce, i, i == cnt - 1, data, dlen, seg,
+                          tmp.data(), seg_ctlen);
+      std::memcpy(text + (beg - off), tmp.data() + (beg - soff), fin - beg);
+    }
+  }
+
+  std::memset(text, 0, !flg * len);
+  return flg;
+}
+
+// Given prepared secret key, 11 -bytes message nonce, N -bytes associated data
+// and sealed message, this routine decrypts and verifies all segments, writing
+// plain text of length computed by `plain_len`, which is zeroed, if sealed
+// message is malformed or any segment fails verification
+inline static bool open(
+    const context_t* const __restrict k,     // prepared secret key
+    const uint8_t* const __restrict nonce,   // 11 -bytes message nonce
+    const uint8_t* const __restrict data,    // N -bytes associated data
+    const size_t dlen,                       // len(data) = N | >= 0
+    const uint8_t* const __restrict sealed,  // sealed message
+    const size_t slen,                       // len(sealed)
+    const size_t seg_len,                    // plain text bytes per segment
+    uint8_t* const __restrict text           // decrypted plain text
+) {
+  size_t ctlen = 0;
+
+  if (!plain_len(slen, seg_len, &ctlen)) {
+    return false;
+  }
+
+  return open_range(k, nonce, data, dlen, sealed, slen, seg_len, 0, text,
+                    ctlen);
+}
+
+// Applies `fn` on each of `cnt` segments, using `threads` -many threads ( or as
+// many as there are hardware threads, if 0 ), where calling thread is one of
+// them. Each thread keeps claiming next unprocessed segment, from a shared
+// counter, until none is left, so that faster threads pick up more segments.
+template<typename F>
+inline static void for_each_segment(const size_t cnt, size_t threads, F&& fn) {
+  if (threads == 0) {
+    threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+  }
+  threads = std::max<size_t>(1, std::min(threads, cnt));
+
+  std::atomic<size_t> next{0ul};
+
+  auto worker = [&]() {
+    while (true) {
+      const size_t i = next.fetch_add(1, std::memory_order_relaxed);
+      if (i >= cnt) {
+        return;
+      }
+      fn(i);
+    }
+  };
+
+  std::vector<std::thread> pool;
+  pool.reserve(threads - 1);
+
+  for (size_t i = 1; i < threads; i++) {
+    pool.emplace_back(worker);
+  }
+
+  worker();
+
+  for (auto& t : pool) {
+    t.join();
+  }
+}
+
+// Same as `seal`, except segments are sealed concurrently, on `threads` -many
+// threads | threads = 0 means as many as there are hardware threads. Output is
+// same as `seal` routine.
+inline static bool seal_parallel(
+    const context_t* const __restrict k,    // prepared secret key
+    const uint8_t* const __restrict nonce,  // 11 -bytes message nonce
+    const uint8_t* const __restrict data,   // N -bytes associated data
+    const size_t dlen,                      // len(data) = N | >= 0
+    const uint8_t* const __restrict text,   // M -bytes plain text
+    const size_t ctlen,                     // len(text) = M | >= 0
+    const size_t seg_len,                   // plain text bytes per segment
+    uint8_t* const __restrict sealed,       // sealed message
+    const size_t threads                    // # -of threads to use
+) {
+  const size_t cnt = segment_count(ctlen, seg_len);
+
+  if ((cnt == 0) || (cnt > MAX_SEGMENTS)) {
+    return false;
+  }
+
+  for_each_segment(cnt, threads, [&](const size_t i) {
+    const size_t off = i * seg_len;
+    const size_t len = std::min(seg_len, ctlen - off);
+
+    seal_segment(k, nonce, i, i == cnt - 1, data, dlen, text + off, len,
+                 sealed + off + (i << 4));
+  });
+
+  return true;
+}
+
+// Same as `open`, except segments are decrypted and verified concurrently, on
+// `threads` -many threads | threads = 0 means as many as there are hardware
+// threads. Whole plain text is zeroed, if any segment fails verification.
+inline static bool open_parallel(
+    const context_t* const __restrict k,     // prepared secret key
+    const uint8_t* const __restrict nonce,   // 11 -bytes message nonce
+    const uint8_t* const __restrict data,    // N -bytes associated data
+    const size_t dlen,                       // len(data) = N | >= 0
+    const uint8_t* const __restrict sealed,  // sealed message
+    const size_t slen,                       // len(sealed)
+    const size_t seg_len,                    // plain text bytes per segment
+    uint8_t* const __restrict text,          // decrypted plain text
+    const size_t threads                     // # -of threads to use
+) {
+  size_t ctlen = 0;
+
+  if (!plain_len(slen, seg_len, &ctlen)) {
+    return false;
+  }
+
+  const size_t cnt = segment_count(ctlen, seg_len);
+  std::atomic<bool> flg{true};
+
+  for_each_segment(cnt, threads, [&](const size_t i) {
+    const size_t off = i * seg_len;
+    const size_t len = std::min(seg_len, ctlen - off);
+
+    const bool f = open_segment(k, nonce, i, i == cnt - 1, data, dlen,
+                                sealed + off + (i << 4), text + off, len);
+    if (!f) {
+      flg.store(false, std::memory_order_relaxed);
+    }
+  });
+
+  const bool ok = flg.load(std::memory_order_relaxed);
+
+  std::memset(text, 0, !ok * ctlen);
+  return ok;
+}
+
+}  // namespace romulus_segmented
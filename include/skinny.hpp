@@ -57,6 +57,50 @@ constexpr uint8_t RC[ROUNDS] = {0x01, 0x03, 0x07, 0x0F, 0x1F, 0x3E, 0x3D, 0x3B,
 constexpr uint8_t P_T[16] = {9, 15, 8, 13, 10, 14, 12, 11,
                              0, 1,  2, 3,  4,  5,  6,  7};
 
+// Position of each tweakey cell after `r` applications of permutation P_T, for
+// r = 0, 1, ..., 40, such that cell found at index i of a tweakey state array,
+// after `r` rounds, is the one found at index TK_POS[r][i] of that array,
+// before first round. P_T has period 16, so TK_POS[r & 15] can also be used,
+// as bitsliced implementation does.
+constexpr auto TK_POS = []() {
+  struct {
+    uint8_t arr[ROUNDS + 1][16];
+  } pos{};
+
+  for (size_t i = 0; i < 16; i++) {
+    pos.arr[0][i] = static_cast<uint8_t>(i);
+  }
+
+  for (size_t r = 0; r < ROUNDS; r++) {
+    for (size_t i = 0; i < 16; i++) {
+      pos.arr[r + 1][i] = pos.arr[r][P_T[i]];
+    }
+  }
+
+  return pos;
+}();
+
+// Round constants of each of 40 rounds, split at compile time into constants
+// of first two cells of first column of internal state, i.e. cells 0 and 4,
+// while constant of third cell is same ( = 0x02 ) in all rounds, so that no
+// round extracts them from `RC`, see `add_constants`
+//
+// See definition of `AddConstants` routine in section 2.3 of Romulus
+// specification
+// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/romulus-spec-final.pdf
+constexpr auto RC_CELLS = []() {
+  struct {
+    uint8_t arr[ROUNDS][2];
+  } rc{};
+
+  for (size_t r = 0; r < ROUNDS; r++) {
+    rc.arr[r][0] = RC[r] & 0x0f;
+    rc.arr[r][1] = (RC[r] >> 4) & 0b11;
+  }
+
+  return rc;
+}();
+
 // Skinny-128-384+ tweakable block cipher ( TBC ) state, where both internal
 // state of 128 -bit & tweakey state of 384 -bit are maintained as four 4x4 byte
 // matrices, using statically allocated 64 -bytes contiguous memory ( read array
@@ -68,6 +112,22 @@ struct state_t {
   uint8_t arr[64];  // 128 -bit internal state + 384 -bit tweakey state
 };
 
+// Round tweakey contributions of tweakey state (3) i.e. first two rows of it,
+// for each of 40 rounds of Skinny-128-384+ TBC. When tweakey state (3) is
+// fixed across many TBC calls ( say it holds secret key ), those can be
+// computed only once, see `expand_tk3` routine.
+struct key_schedule_t {
+  uint8_t rtk3[ROUNDS][8];
+};
+
+// Round tweakey contributions of tweakey state (2, 3) combined, for each of 40
+// rounds of Skinny-128-384+ TBC. When both of them are fixed across many TBC
+// calls ( say they hold nonce and secret key ), while only tweakey state (1)
+// changes, those can be computed only once, see `expand_tk2` routine.
+struct tweakey_schedule_t {
+  uint8_t rtk23[ROUNDS][8];
+};
+
 // Initialize both internal state and tweakey state of Skinny-128-384+ TBC
 //
 // See section 2.3 of Romulus specification
@@ -91,20 +151,17 @@ inline static void sub_cells(state_t* const __restrict st) {
   }
 }
 
-// Add round constants to first column of internal state of TBC
+// Add round constants, already split into cells, see `RC_CELLS`, to first
+// column of internal state of TBC
 //
 // See definition of `AddConstants` routine in section 2.3 of Romulus
 // specification
 // https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/romulus-spec-final.pdf
 inline static void add_constants(state_t* const __restrict st,
-                                 const size_t r_idx) {
-  const uint8_t c0 = RC[r_idx] & 0x0f;
-  const uint8_t c1 = (RC[r_idx] >> 4) & 0b11;
-  constexpr uint8_t c2 = 0x02;
-
-  st->arr[0] ^= c0;
-  st->arr[4] ^= c1;
-  st->arr[8] ^= c2;
+                                 const uint8_t* const __restrict rc) {
+  st->arr[0] ^= rc[0];
+  st->arr[4] ^= rc[1];
+  st->arr[8] ^= 0x02;
 }
 
 // LFSR used to update each cell of first two rows of tweakey state (2)
@@ -129,41 +186,154 @@ inline static uint8_t tk3_lfsr(const uint8_t cell) {
   return ((x0 ^ x6) << 7) | ((cell & 0b11111110) >> 1);
 }
 
-// First two rows of all tweakey state arrays are extracted and added into
-// internal state's first two rows & then tweakey states are updated by applying
-// permutation and LFSR
+// Applies LFSRs, in place, on cells of tweakey states (2, 3), among first
+// `tks` -many ones, which enter first two rows of tweakey state in round `r`.
+// Tweakey cells are not moved around by P_T, instead cells of round `r` are
+// read from their positions after `r` applications of P_T, see `TK_POS`. As
+// each cell moves into first two rows once every two rounds, LFSRs are applied
+// just before cells are used, in rounds r > 0, while tweakey states are brought
+// to their permuted arrangement by `finish_tweakey`, after last round.
+//
+// See definition of `AddRoundTweakey` routine in section 2.3 of Romulus
+// specification
+// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/romulus-spec-final.pdf
+inline static void update_tweakey_at(state_t* const __restrict st,
+                                     const size_t r,
+                                     const size_t tks) {
+  const uint8_t* const pos = TK_POS.arr[r];
+
+  if ((r > 0) & (tks > 1)) {
+    for (size_t i = 0; i < 8; i++) {
+      st->arr[32 + pos[i]] = tk2_lfsr(st->arr[32 + pos[i]]);
+    }
+  }
+  if ((r > 0) & (tks > 2)) {
+    for (size_t i = 0; i < 8; i++) {
+      st->arr[48 + pos[i]] = tk3_lfsr(st->arr[48 + pos[i]]);
+    }
+  }
+}
+
+// Adds round tweakey of round `r`, read from first two rows of all tweakey
+// state arrays ( see `update_tweakey_at` ), to first two rows of internal state
 //
 // See definition of `AddRoundTweakey` routine in section 2.3 of Romulus
 // specification
 // https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/romulus-spec-final.pdf
-inline static void add_round_tweakey(state_t* const __restrict st) {
+inline static void add_round_tweakey_at(state_t* const __restrict st,
+                                        const size_t r) {
+  const uint8_t* const pos = TK_POS.arr[r];
+
+  update_tweakey_at(st, r, 3);
+
   for (size_t i = 0; i < 8; i++) {
-    st->arr[i] ^= (st->arr[16 + i] ^ st->arr[32 + i] ^ st->arr[48 + i]);
+    const size_t p = pos[i];
+    st->arr[i] ^= st->arr[16 + p] ^ st->arr[32 + p] ^ st->arr[48 + p];
   }
+}
 
-  uint8_t tmp[16];
+// Same as above `add_round_tweakey_at`, except contribution of tweakey state
+// (3) is taken from precomputed round tweakeys, so that only tweakey state
+// (1, 2) are updated. Note, last 16 -bytes of state array are not used.
+inline static void add_round_tweakey_at(state_t* const __restrict st,
+                                        const size_t r,
+                                        const uint8_t* const __restrict rtk3) {
+  const uint8_t* const pos = TK_POS.arr[r];
 
-  for (size_t i = 0; i < 16; i++) {
-    tmp[i] = st->arr[16 + P_T[i]];
+  update_tweakey_at(st, r, 2);
+
+  for (size_t i = 0; i < 8; i++) {
+    const size_t p = pos[i];
+    st->arr[i] ^= st->arr[16 + p] ^ st->arr[32 + p] ^ rtk3[i];
   }
-  std::memcpy(st->arr + 16, tmp, 16);
+}
 
-  for (size_t i = 0; i < 16; i++) {
-    tmp[i] = st->arr[32 + P_T[i]];
+// Brings first `tks` -many tweakey states to same arrangement, as they'd have
+// after being permuted by P_T ( and updated by LFSRs ) in each of 40 rounds,
+// when round tweakeys are added using `add_round_tweakey_at`
+inline static void finish_tweakey(state_t* const __restrict st,
+                                  const size_t tks) {
+  const uint8_t* const pos = TK_POS.arr[ROUNDS];
+
+  if (tks > 1) {
+    for (size_t i = 0; i < 8; i++) {
+      st->arr[32 + pos[i]] = tk2_lfsr(st->arr[32 + pos[i]]);
+    }
+  }
+  if (tks > 2) {
+    for (size_t i = 0; i < 8; i++) {
+      st->arr[48 + pos[i]] = tk3_lfsr(st->arr[48 + pos[i]]);
+    }
   }
-  std::memcpy(st->arr + 32, tmp, 16);
 
-  for (size_t i = 0; i < 16; i++) {
-    tmp[i] = st->arr[48 + P_T[i]];
+  uint8_t tmp[16];
+
+  for (size_t t = 1; t <= tks; t++) {
+    uint8_t* const tk = st->arr + (t << 4);
+
+    for (size_t i = 0; i < 16; i++) {
+      tmp[i] = tk[pos[i]];
+    }
+    std::memcpy(tk, tmp, 16);
   }
-  std::memcpy(st->arr + 48, tmp, 16);
+}
 
-  for (size_t i = 0; i < 8; i++) {
-    st->arr[32 + i] = tk2_lfsr(st->arr[32 + i]);
+// Computes round tweakey contributions of tweakey state (3), for all 40 rounds
+// of Skinny-128-384+ TBC, by applying permutation P_T and LFSR on it
+//
+// See definition of `AddRoundTweakey` routine in section 2.3 of Romulus
+// specification
+// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/romulus-spec-final.pdf
+inline static void expand_tk3(
+    key_schedule_t* const __restrict ks,  // 40 rounds of TK3 contributions
+    const uint8_t* const __restrict tk3   // 16 -bytes tweakey state (3)
+) {
+  uint8_t tk[16];
+  uint8_t tmp[16];
+
+  std::memcpy(tk, tk3, 16);
+
+  for (size_t r = 0; r < ROUNDS; r++) {
+    std::memcpy(ks->rtk3[r], tk, 8);
+
+    for (size_t i = 0; i < 16; i++) {
+      tmp[i] = tk[P_T[i]];
+    }
+
+    for (size_t i = 0; i < 8; i++) {
+      tk[i] = tk3_lfsr(tmp[i]);
+    }
+    std::memcpy(tk + 8, tmp + 8, 8);
   }
+}
 
-  for (size_t i = 0; i < 8; i++) {
-    st->arr[48 + i] = tk3_lfsr(st->arr[48 + i]);
+// Computes round tweakey contributions of tweakey state (2), for all 40
+// rounds, combining them with already expanded round tweakeys of tweakey state
+// (3), so that TBC calls sharing both of them only need to permute tweakey
+// state (1), which isn't updated by any LFSR
+inline static void expand_tk2(
+    tweakey_schedule_t* const __restrict ts,   // 40 rounds of TK2 ^ TK3
+    const uint8_t* const __restrict tk2,       // 16 -bytes tweakey state (2)
+    const key_schedule_t* const __restrict ks  // 40 rounds of TK3
+) {
+  uint8_t tk[16];
+  uint8_t tmp[16];
+
+  std::memcpy(tk, tk2, 16);
+
+  for (size_t r = 0; r < ROUNDS; r++) {
+    for (size_t i = 0; i < 8; i++) {
+      ts->rtk23[r][i] = tk[i] ^ ks->rtk3[r][i];
+    }
+
+    for (size_t i = 0; i < 16; i++) {
+      tmp[i] = tk[P_T[i]];
+    }
+
+    for (size_t i = 0; i < 8; i++) {
+      tk[i] = tk2_lfsr(tmp[i]);
+    }
+    std::memcpy(tk + 8, tmp + 8, 8);
   }
 }
 
@@ -234,22 +404,174 @@ static inline void mix_columns(state_t* const __restrict st) {
   st->arr[15] = tmp[0] ^ tmp[2];
 }
 
-// A single round of Skinny-128-384+ tweakable block cipher
-inline static void round(state_t* const __restrict st, const size_t r_idx) {
-  sub_cells(st);
-  add_constants(st, r_idx);
-  add_round_tweakey(st);
-  shift_rows(st);
-  mix_columns(st);
-}
-
 // Skinny-128-384+ tweakable block cipher with 40 rounds, see section 2.3 of
 // Romulus specification
 // https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/romulus-spec-final.pdf
 inline static void tbc(state_t* const __restrict st) {
   for (size_t i = 0; i < ROUNDS; i++) {
-    round(st, i);
+    sub_cells(st);
+    add_constants(st, RC_CELLS.arr[i]);
+    add_round_tweakey_at(st, i);
+    shift_rows(st);
+    mix_columns(st);
+  }
+
+  finish_tweakey(st, 3);
+}
+
+// Skinny-128-384+ tweakable block cipher with 40 rounds, where tweakey state
+// (3) is already expanded into round tweakeys, using `expand_tk3` routine. Only
+// first 48 -bytes of state array ( i.e. internal state and tweakey state (1, 2)
+// ) are used.
+inline static void tbc(state_t* const __restrict st,
+                       const key_schedule_t* const __restrict ks) {
+  for (size_t i = 0; i < ROUNDS; i++) {
+    sub_cells(st);
+    add_constants(st, RC_CELLS.arr[i]);
+    add_round_tweakey_at(st, i, ks->rtk3[i]);
+    shift_rows(st);
+    mix_columns(st);
+  }
+
+  finish_tweakey(st, 2);
+}
+
+// Skinny-128-384+ tweakable block cipher with 40 rounds, where tweakey state
+// (2, 3) are already expanded into combined round tweakeys, using `expand_tk2`
+// routine. Only first 32 -bytes of state array ( i.e. internal state and
+// tweakey state (1) ) are used.
+inline static void tbc(state_t* const __restrict st,
+                       const tweakey_schedule_t* const __restrict ts) {
+  for (size_t i = 0; i < ROUNDS; i++) {
+    sub_cells(st);
+    add_constants(st, RC_CELLS.arr[i]);
+
+    const uint8_t* const pos = TK_POS.arr[i];
+    for (size_t j = 0; j < 8; j++) {
+      st->arr[j] ^= st->arr[16 + pos[j]] ^ ts->rtk23[i][j];
+    }
+
+    shift_rows(st);
+    mix_columns(st);
+  }
+
+  finish_tweakey(st, 1);
+}
+
+// Skinny-128-384+ tweakable block cipher with 40 rounds, encrypting two
+// independent states `st0` and `st1`, each under its own tweakey state (1, 2),
+// while sharing round tweakeys of tweakey state (3), precomputed using
+// `expand_tk3` routine. Rounds of both states are interleaved, so that two
+// otherwise serial chains of TBC calls can be processed in lockstep.
+inline static void tbc_pair(state_t* const __restrict st0,
+                            state_t* const __restrict st1,
+                            const key_schedule_t* const __restrict ks) {
+  for (size_t i = 0; i < ROUNDS; i++) {
+    sub_cells(st0);
+    sub_cells(st1);
+
+    add_constants(st0, RC_CELLS.arr[i]);
+    add_constants(st1, RC_CELLS.arr[i]);
+
+    add_round_tweakey_at(st0, i, ks->rtk3[i]);
+    shift_rows(st0);
+    mix_columns(st0);
+
+    add_round_tweakey_at(st1, i, ks->rtk3[i]);
+    shift_rows(st1);
+    mix_columns(st1);
+  }
+
+  finish_tweakey(st0, 2);
+  finish_tweakey(st1, 2);
+}
+
+// Skinny-128-384+ tweakable block cipher with 40 rounds, encrypting internal
+// state of `st` and another 16 -bytes block `blk`, both under tweakey state of
+// `st`, such that tweakey state is updated only once per round, for both of
+// them
+inline static void tbc2(state_t* const __restrict st,
+                        uint8_t* const __restrict blk) {
+  state_t tmp;
+  std::memcpy(tmp.arr, blk, 16);
+
+  for (size_t i = 0; i < ROUNDS; i++) {
+    sub_cells(st);
+    sub_cells(&tmp);
+
+    add_constants(st, RC_CELLS.arr[i]);
+    add_constants(&tmp, RC_CELLS.arr[i]);
+
+    const uint8_t* const pos = TK_POS.arr[i];
+    update_tweakey_at(st, i, 3);
+
+    for (size_t j = 0; j < 8; j++) {
+      const size_t p = pos[j];
+      const uint8_t k = st->arr[16 + p] ^ st->arr[32 + p] ^ st->arr[48 + p];
+
+      st->arr[j] ^= k;
+      tmp.arr[j] ^= k;
+    }
+
+    shift_rows(st);
+    shift_rows(&tmp);
+
+    mix_columns(st);
+    mix_columns(&tmp);
+  }
+
+  finish_tweakey(st, 3);
+  std::memcpy(blk, tmp.arr, 16);
+}
+
+// Skinny-128-384+ tweakable block cipher with 40 rounds, encrypting internal
+// state of `st` under two tweakeys, which differ only in tweakey state (1) i.e.
+// first one is tweakey state of `st`, while second one has its tweakey state
+// (1) replaced by `tk1`. Encrypted block under first tweakey is kept in `st`,
+// while one under second tweakey is written to `blk`.
+//
+// As tweakey state (1) is only permuted by P_T, round tweakey of second one is
+// computed by adding difference of tweakey states (1), read from its permuted
+// positions ( see `TK_POS` ), to round tweakey of first one.
+inline static void tbc2_tk1(state_t* const __restrict st,
+                            const uint8_t* const __restrict tk1,
+                            uint8_t* const __restrict blk) {
+  state_t tmp;
+  uint8_t diff[16];
+
+  std::memcpy(tmp.arr, st->arr, 16);
+
+  for (size_t i = 0; i < 16; i++) {
+    diff[i] = st->arr[16 + i] ^ tk1[i];
+  }
+
+  for (size_t i = 0; i < ROUNDS; i++) {
+    sub_cells(st);
+    sub_cells(&tmp);
+
+    add_constants(st, RC_CELLS.arr[i]);
+    add_constants(&tmp, RC_CELLS.arr[i]);
+
+    const uint8_t* const pos = TK_POS.arr[i];
+    update_tweakey_at(st, i, 3);
+
+    for (size_t j = 0; j < 8; j++) {
+      const size_t p = pos[j];
+      const uint8_t k = st->arr[16 + p] ^ st->arr[32 + p] ^ st->arr[48 + p];
+
+      st->arr[j] ^= k;
+      tmp.arr[j] ^= k ^ diff[p];
+    }
+
+    shift_rows(st);
+    shift_rows(&tmp);
+
+    mix_columns(st);
+    mix_columns(&tmp);
   }
+
+  finish_tweakey(st, 3);
+  std::memcpy(blk, tmp.arr, 16);
 }
 
 }  // namespace skinny
@@ -0,0 +1,348 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "skinny.hpp"
+#include "skinny_simd.hpp"
+
+// Bitsliced Skinny-128-384+ Tweakable Block Cipher, encrypting many independent
+// ( state, tweakey ) pairs in a single call
+namespace skinny_bitsliced {
+
+// Unsigned integer type used for holding a single bit slice, where i -th bit of
+// each word belongs to i -th block, so that {8, 16, 32, 64} -bit wide words
+// process that many blocks in parallel
+template<typename T>
+concept lane_word =
+    std::is_same_v<T, uint8_t> || std::is_same_v<T, uint16_t> ||
+    std::is_same_v<T, uint32_t> || std::is_same_v<T, uint64_t>;
+
+// Number of blocks processed in parallel, when bit slices are of type T
+template<lane_word T>
+constexpr size_t LANES = sizeof(T) << 3;
+
+// Bitsliced Skinny-128-384+ state, where arr[i][j] holds j -th bit of i -th
+// byte of skinny::state_t::arr, for all blocks being processed in parallel
+template<lane_word T>
+struct state_t {
+  T arr[64][8];  // 128 -bit internal state + 384 -bit tweakey state
+};
+
+// Transposes 8x8 bit matrix, where i -th byte of input word is i -th row
+//
+// See section 7-3 of Hacker's Delight ( 2nd edition )
+inline static uint64_t transpose8x8(uint64_t x) {
+  uint64_t t;
+
+  t = (x ^ (x >> 7)) & 0x00aa00aa00aa00aaul;
+  x ^= t ^ (t << 7);
+  t = (x ^ (x >> 14)) & 0x0000cccc0000ccccul;
+  x ^= t ^ (t << 14);
+  t = (x ^ (x >> 28)) & 0x00000000f0f0f0f0ul;
+  x ^= t ^ (t << 28);
+
+  return x;
+}
+
+// Converts first `cells` -many bytes of LANES<T> -many Skinny-128-384+ states to
+// bitsliced representation
+template<lane_word T>
+inline static void pack(state_t<T>* const __restrict bst,
+                        const skinny::state_t* const __restrict sts,
+                        const size_t cells = 64) {
+  for (size_t i = 0; i < cells; i++) {
+    T slices[8]{};
+
+    for (size_t g = 0; g < LANES<T>; g += 8) {
+      uint64_t x = 0;
+
+      for (size_t k = 0; k < 8; k++) {
+        x |= static_cast<uint64_t>(sts[g + k].arr[i]) << (k << 3);
+      }
+
+      const uint64_t y = transpose8x8(x);
+
+      for (size_t j = 0; j < 8; j++) {
+        const T slice = static_cast<T>((y >> (j << 3)) & 0xff);
+        slices[j] |= static_cast<T>(slice << g);
+      }
+    }
+
+    std::memcpy(bst->arr[i], slices, sizeof(slices));
+  }
+}
+
+// Converts internal state portion of bitsliced representation back to LANES<T>
+// -many Skinny-128-384+ states, leaving their tweakey portion untouched
+template<lane_word T>
+inline static void unpack(skinny::state_t* const __restrict sts,
+                          const state_t<T>* const __restrict bst) {
+  for (size_t i = 0; i < 16; i++) {
+    const T* const slices = bst->arr[i];
+
+    for (size_t g = 0; g < LANES<T>; g += 8) {
+      uint64_t x = 0;
+
+      for (size_t j = 0; j < 8; j++) {
+        x |= static_cast<uint64_t>((slices[j] >> g) & 0xff) << (j << 3);
+      }
+
+      const uint64_t y = transpose8x8(x);
+
+      for (size_t k = 0; k < 8; k++) {
+        sts[g + k].arr[i] = static_cast<uint8_t>(y >> (k << 3));
+      }
+    }
+  }
+}
+
+// Bitsliced form of 8 -bit Skinny Sbox, which is computed as four layers of
+// x4 ^= ~(x7 | x6), x0 ^= ~(x3 | x2), interleaved with bit permutations. Those
+// permutations are applied by renaming the slices, so they don't cost anything.
+//
+// See section 2.3 of Romulus specification
+// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/romulus-spec-final.pdf
+template<lane_word T>
+inline static void sbox(T* const x) {
+  T a0 = x[0], a1 = x[1], a2 = x[2], a3 = x[3];
+  T a4 = x[4], a5 = x[5], a6 = x[6], a7 = x[7];
+
+  a4 ^= static_cast<T>(~(a7 | a6));
+  a0 ^= static_cast<T>(~(a3 | a2));
+  a6 ^= static_cast<T>(~(a2 | a1));
+  a5 ^= static_cast<T>(~(a4 | a0));
+  a1 ^= static_cast<T>(~(a0 | a3));
+  a7 ^= static_cast<T>(~(a6 | a5));
+  a3 ^= static_cast<T>(~(a5 | a4));
+  a2 ^= static_cast<T>(~(a1 | a7));
+
+  x[0] = a2, x[1] = a7, x[2] = a6, x[3] = a1;
+  x[4] = a3, x[5] = a0, x[6] = a4, x[7] = a5;
+}
+
+// Bitsliced form of skinny::tk2_lfsr
+template<lane_word T>
+inline static void tk2_lfsr(T* const x) {
+  const T t = x[7] ^ x[5];
+
+  for (size_t i = 7; i > 0; i--) {
+    x[i] = x[i - 1];
+  }
+  x[0] = t;
+}
+
+// Bitsliced form of skinny::tk3_lfsr
+template<lane_word T>
+inline static void tk3_lfsr(T* const x) {
+  const T t = x[0] ^ x[6];
+
+  for (size_t i = 0; i < 7; i++) {
+    x[i] = x[i + 1];
+  }
+  x[7] = t;
+}
+
+// A single round of bitsliced Skinny-128-384+, which reads internal state from
+// `src` and writes updated internal state to `dst`, while updating tweakey
+// cells of `bst` in place. When `rtk3` is non-null, contribution of tweakey
+// state (3), shared by all lanes, is taken from it, instead of from `bst`.
+template<lane_word T>
+inline static void round(state_t<T>* const bst, T (*const src)[8],
+                         T (*const dst)[8], const size_t r_idx,
+                         const uint8_t* const rtk3 = nullptr) {
+  T(*const tk)[8] = bst->arr + 16;
+
+  // SubCells
+  for (size_t i = 0; i < 16; i++) {
+    sbox(src[i]);
+  }
+
+  // AddConstants
+  const uint8_t c0 = skinny::RC_CELLS.arr[r_idx][0];
+  const uint8_t c1 = skinny::RC_CELLS.arr[r_idx][1];
+  constexpr uint8_t c2 = 0x02;
+
+  for (size_t j = 0; j < 4; j++) {
+    src[0][j] ^= static_cast<T>(-static_cast<T>((c0 >> j) & 1));
+  }
+  for (size_t j = 0; j < 2; j++) {
+    src[4][j] ^= static_cast<T>(-static_cast<T>((c1 >> j) & 1));
+  }
+  src[8][1] ^= static_cast<T>(-static_cast<T>((c2 >> 1) & 1));
+
+  // AddRoundTweakey, where tweakey cells are never physically moved by P_T,
+  // instead cell living at logical position j is looked up, see skinny::TK_POS
+  const uint8_t* const pos0 = skinny::TK_POS.arr[r_idx & 15];
+  const uint8_t* const pos1 = skinny::TK_POS.arr[(r_idx + 1) & 15];
+
+  if (rtk3 == nullptr) {
+    for (size_t i = 0; i < 8; i++) {
+      const size_t p = pos0[i];
+
+      for (size_t j = 0; j < 8; j++) {
+        src[i][j] ^= tk[p][j] ^ tk[16 + p][j] ^ tk[32 + p][j];
+      }
+    }
+
+    for (size_t i = 0; i < 8; i++) {
+      const size_t p = pos1[i];
+
+      tk2_lfsr(tk[16 + p]);
+      tk3_lfsr(tk[32 + p]);
+    }
+  } else {
+    for (size_t i = 0; i < 8; i++) {
+      const size_t p = pos0[i];
+
+      for (size_t j = 0; j < 8; j++) {
+        const T k = static_cast<T>(-static_cast<T>((rtk3[i] >> j) & 1));
+        src[i][j] ^= tk[p][j] ^ tk[16 + p][j] ^ k;
+      }
+    }
+
+    for (size_t i = 0; i < 8; i++) {
+      tk2_lfsr(tk[16 + pos1[i]]);
+    }
+  }
+
+  // ShiftRows, followed by MixColumns
+  for (size_t c = 0; c < 4; c++) {
+    const T* const a0 = src[0 + c];
+    const T* const a1 = src[4 + ((c - 1) & 3)];
+    const T* const a2 = src[8 + ((c - 2) & 3)];
+    const T* const a3 = src[12 + ((c - 3) & 3)];
+
+    for (size_t j = 0; j < 8; j++) {
+      dst[0 + c][j] = a0[j] ^ a2[j] ^ a3[j];
+      dst[4 + c][j] = a0[j];
+      dst[8 + c][j] = a1[j] ^ a2[j];
+      dst[12 + c][j] = a0[j] ^ a2[j];
+    }
+  }
+}
+
+// Skinny-128-384+ tweakable block cipher, applied on LANES<T> -many independent
+// states, producing same encrypted block as calling skinny::tbc on each of them.
+//
+// Note, unlike skinny::tbc, tweakey portion of states are left as they were,
+// because none of Romulus modes read it back after encryption.
+template<lane_word T>
+inline static void tbc(skinny::state_t* const sts) {
+  state_t<T> bst;
+  T tmp[16][8];
+
+  pack(&bst, sts);
+
+  for (size_t i = 0; i < skinny::ROUNDS; i += 2) {
+    round(&bst, bst.arr, tmp, i);
+    round(&bst, tmp, bst.arr, i + 1);
+  }
+
+  unpack(sts, &bst);
+}
+
+// Skinny-128-384+ tweakable block cipher, applied on LANES<T> -many independent
+// states, all sharing same tweakey state (3), which is already expanded into
+// round tweakeys, producing same encrypted block as calling skinny::tbc on each
+// of them. Only first 48 -bytes of each state are used.
+template<lane_word T>
+inline static void tbc(skinny::state_t* const sts,
+                       const skinny::key_schedule_t* const __restrict ks) {
+  state_t<T> bst;
+  T tmp[16][8];
+
+  pack(&bst, sts, 48);
+
+  for (size_t i = 0; i < skinny::ROUNDS; i += 2) {
+    round(&bst, bst.arr, tmp, i, ks->rtk3[i]);
+    round(&bst, tmp, bst.arr, i + 1, ks->rtk3[i + 1]);
+  }
+
+  unpack(sts, &bst);
+}
+
+// Skinny-128-384+ tweakable block cipher, applied on N -many independent states
+// | N >= 0, producing same encrypted blocks as calling skinny::tbc on each of
+// them ( tweakey portion of states may or may not be updated ).
+//
+// Widest bitsliced routine is used for each chunk of 64 states. Remaining tail
+// is processed block by block, using vectorized Skinny-128-384+, if CPU
+// supports that, otherwise it's padded upto next lane count, when that's
+// cheaper than processing it block by block using portable implementation.
+inline static void tbc_many(skinny::state_t* const sts, const size_t n) {
+  size_t off = 0;
+
+  while (n - off >= LANES<uint64_t>) {
+    tbc<uint64_t>(sts + off);
+    off += LANES<uint64_t>;
+  }
+
+  const size_t rm = n - off;
+  const bool portable = skinny_simd::isa() == skinny_simd::isa_t::portable;
+
+  if ((rm < LANES<uint8_t>) || !portable) {
+    for (size_t i = off; i < n; i++) {
+      skinny_simd::tbc(sts + i);
+    }
+    return;
+  }
+
+  skinny::state_t tmp[LANES<uint64_t>]{};
+  std::memcpy(tmp, sts + off, rm * sizeof(skinny::state_t));
+
+  if (rm <= LANES<uint8_t>) {
+    tbc<uint8_t>(tmp);
+  } else if (rm <= LANES<uint16_t>) {
+    tbc<uint16_t>(tmp);
+  } else if (rm <= LANES<uint32_t>) {
+    tbc<uint32_t>(tmp);
+  } else {
+    tbc<uint64_t>(tmp);
+  }
+
+  std::memcpy(sts + off, tmp, rm * sizeof(skinny::state_t));
+}
+
+// Skinny-128-384+ tweakable block cipher, applied on N -many independent states
+// | N >= 0, all sharing same tweakey state (3), which is already expanded into
+// round tweakeys, producing same encrypted blocks as calling skinny::tbc on
+// each of them. Only first 48 -bytes of each state are used. Chunks are
+// processed same way as above `tbc_many` routine does.
+inline static void tbc_many(skinny::state_t* const sts, const size_t n,
+                            const skinny::key_schedule_t* const __restrict ks) {
+  size_t off = 0;
+
+  while (n - off >= LANES<uint64_t>) {
+    tbc<uint64_t>(sts + off, ks);
+    off += LANES<uint64_t>;
+  }
+
+  const size_t rm = n - off;
+  const bool portable = skinny_simd::isa() == skinny_simd::isa_t::portable;
+
+  if ((rm < LANES<uint8_t>) || !portable) {
+    for (size_t i = off; i < n; i++) {
+      skinny_simd::tbc(sts + i, ks);
+    }
+    return;
+  }
+
+  skinny::state_t tmp[LANES<uint64_t>]{};
+  std::memcpy(tmp, sts + off, rm * sizeof(skinny::state_t));
+
+  if (rm <= LANES<uint8_t>) {
+    tbc<uint8_t>(tmp, ks);
+  } else if (rm <= LANES<uint16_t>) {
+    tbc<uint16_t>(tmp, ks);
+  } else if (rm <= LANES<uint32_t>) {
+    tbc<uint32_t>(tmp, ks);
+  } else {
+    tbc<uint64_t>(tmp, ks);
+  }
+
+  std::memcpy(sts + off, tmp, rm * sizeof(skinny::state_t));
+}
+
+}  // namespace skinny_bitsliced
@@ -0,0 +1,366 @@
+#pragma once
+#include <bit>
+
+#include "skinny.hpp"
+
+// Skinny-128-384+ Tweakable Block Cipher, where each 4 -bytes row of internal
+// state is kept in a 32 -bit word and each 16 -bytes tweakey state is kept in
+// two 64 -bit words, such that `ShiftRows` becomes word rotation, `MixColumns`
+// becomes a few row XORs, permutation P_T becomes byte shuffle of 64 -bit words
+// and LFSRs are applied on eight cells together. It doesn't need any
+// instruction set extension, while it's a drop-in replacement of skinny::tbc*
+// routines, which is why it's used by run time dispatcher of skinny_simd.hpp,
+// when vectorized implementations can't be used.
+//
+// Cell j of row i, of a 4x4 byte matrix, is kept in bits [8j, 8j + 8) of
+// row word i, while row {0, 1} and row {2, 3} of tweakey state are kept in low
+// and high 64 -bit words, respectively.
+namespace skinny_rows {
+
+// Tweakey state, where first two rows ( which are added into internal state,
+// during each round ) are kept in `lo`, while last two rows are kept in `hi`
+struct tweakey_t {
+  uint64_t lo;
+  uint64_t hi;
+};
+
+// Loads 4 -bytes row, in little endian order
+inline static uint32_t load_row(const uint8_t* const __restrict bytes) {
+  return (static_cast<uint32_t>(bytes[3]) << 24) |
+         (static_cast<uint32_t>(bytes[2]) << 16) |
+         (static_cast<uint32_t>(bytes[1]) << 8) |
+         (static_cast<uint32_t>(bytes[0]) << 0);
+}
+
+// Stores 4 -bytes row, in little endian order
+inline static void store_row(const uint32_t row,
+                             uint8_t* const __restrict bytes) {
+  for (size_t i = 0; i < 4; i++) {
+    bytes[i] = static_cast<uint8_t>(row >> (i << 3));
+  }
+}
+
+// Loads 8 -bytes i.e. two rows, in little endian order
+inline static uint64_t load_rows(const uint8_t* const __restrict bytes) {
+  return (static_cast<uint64_t>(load_row(bytes + 4)) << 32) | load_row(bytes);
+}
+
+// Stores 8 -bytes i.e. two rows, in little endian order
+inline static void store_rows(const uint64_t rows,
+                              uint8_t* const __restrict bytes) {
+  store_row(static_cast<uint32_t>(rows), bytes);
+  store_row(static_cast<uint32_t>(rows >> 32), bytes + 4);
+}
+
+inline static tweakey_t load_tk(const uint8_t* const __restrict bytes) {
+  return {load_rows(bytes), load_rows(bytes + 8)};
+}
+
+inline static void store_tk(const tweakey_t& tk,
+                            uint8_t* const __restrict bytes) {
+  store_rows(tk.lo, bytes);
+  store_rows(tk.hi, bytes + 8);
+}
+
+// Substitutes all four cells of a row by applying 8 -bit Sbox
+//
+// See section 2.3 of Romulus specification
+// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/romulus-spec-final.pdf
+inline static uint32_t sub_cells(const uint32_t x) {
+  return (static_cast<uint32_t>(skinny::S8[(x >> 24) & 0xff]) << 24) |
+         (static_cast<uint32_t>(skinny::S8[(x >> 16) & 0xff]) << 16) |
+         (static_cast<uint32_t>(skinny::S8[(x >> 8) & 0xff]) << 8) |
+         (static_cast<uint32_t>(skinny::S8[(x >> 0) & 0xff]) << 0);
+}
+
+// Applies permutation P_T on tweakey state, where last two rows become first
+// two rows, while first two rows become last two rows, after their cells are
+// shuffled, such that cell i of first two rows is cell P_T[i] - 8 of last two
+// rows i.e. {1, 7, 0, 5, 2, 6, 4, 3}
+//
+// See figure 2.3 of Romulus specification
+// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/romulus-spec-final.pdf
+inline static void permute_tk(tweakey_t& tk) {
+  const uint64_t hi = tk.hi;
+
+  tk.hi = tk.lo;
+  tk.lo = ((hi >> 8) & 0x0000ff00000000fful) |
+          ((hi >> 48) & 0x000000000000ff00ul) |
+          ((hi << 16) & 0x00ff00ff00ff0000ul) |
+          ((hi >> 16) & 0x00000000ff000000ul) |
+          ((hi << 32) & 0xff00000000000000ul);
+}
+
+// LFSR used to update each cell of first two rows of tweakey state (2), applied
+// on all eight of them together, see `skinny::tk2_lfsr`
+inline static uint64_t tk2_lfsr(const uint64_t x) {
+  return ((x << 1) & 0xfefefefefefefefeul) ^
+         (((x >> 7) ^ (x >> 5)) & 0x0101010101010101ul);
+}
+
+// LFSR used to update each cell of first two rows of tweakey state (3), applied
+// on all eight of them together, see `skinny::tk3_lfsr`
+inline static uint64_t tk3_lfsr(const uint64_t x) {
+  return ((x >> 1) & 0x7f7f7f7f7f7f7f7ful) ^
+         (((x << 7) ^ (x << 1)) & 0x8080808080808080ul);
+}
+
+// A single round of Skinny-128-384+ tweakable block cipher, on internal state
+// kept as four row words, where first two rows of round tweakey are `rtk`
+inline static void round(uint32_t* const __restrict row,
+                         const uint64_t rtk,
+                         const size_t r_idx) {
+  row[0] = sub_cells(row[0]);
+  row[1] = sub_cells(row[1]);
+  row[2] = sub_cells(row[2]);
+  row[3] = sub_cells(row[3]);
+
+  const uint32_t c0 = skinny::RC_CELLS.arr[r_idx][0];
+  const uint32_t c1 = skinny::RC_CELLS.arr[r_idx][1];
+  constexpr uint32_t c2 = 0x02;
+
+  row[0] ^= c0 ^ static_cast<uint32_t>(rtk);
+  row[1] ^= c1 ^ static_cast<uint32_t>(rtk >> 32);
+  row[2] ^= c2;
+
+  const uint32_t r1 = std::rotl(row[1], 8);
+  const uint32_t r2 = std::rotl(row[2], 16);
+  const uint32_t r3 = std::rotl(row[3], 24);
+
+  row[1] = row[0];
+  row[0] ^= r2 ^ r3;
+  row[3] = row[1] ^ r2;
+  row[2] = r1 ^ r2;
+}
+
+inline static void load_state(const skinny::state_t* const __restrict st,
+                              uint32_t* const __restrict row) {
+  for (size_t i = 0; i < 4; i++) {
+    row[i] = load_row(st->arr + (i << 2));
+  }
+}
+
+inline static void store_state(const uint32_t* const __restrict row,
+                               skinny::state_t* const __restrict st) {
+  for (size_t i = 0; i < 4; i++) {
+    store_row(row[i], st->arr + (i << 2));
+  }
+}
+
+// Skinny-128-384+ tweakable block cipher with 40 rounds, producing same
+// internal state and tweakey state as skinny::tbc does
+inline static void tbc(skinny::state_t* const __restrict st) {
+  uint32_t row[4];
+  load_state(st, row);
+
+  tweakey_t tk1 = load_tk(st->arr + 16);
+  tweakey_t tk2 = load_tk(st->arr + 32);
+  tweakey_t tk3 = load_tk(st->arr + 48);
+
+  for (size_t i = 0; i < skinny::ROUNDS; i++) {
+    round(row, tk1.lo ^ tk2.lo ^ tk3.lo, i);
+
+    permute_tk(tk1);
+    permute_tk(tk2);
+    permute_tk(tk3);
+
+    tk2.lo = tk2_lfsr(tk2.lo);
+    tk3.lo = tk3_lfsr(tk3.lo);
+  }
+
+  store_state(row, st);
+  store_tk(tk1, st->arr + 16);
+  store_tk(tk2, st->arr + 32);
+  store_tk(tk3, st->arr + 48);
+}
+
+// Skinny-128-384+ tweakable block cipher with 40 rounds, where tweakey state
+// (3) is already expanded into round tweakeys, using skinny::expand_tk3
+// routine, producing same internal state and tweakey state (1, 2) as
+// skinny::tbc does. Only first 48 -bytes of state array are used.
+inline static void tbc(skinny::state_t* const __restrict st,
+                       const skinny::key_schedule_t* const __restrict ks) {
+  uint32_t row[4];
+  load_state(st, row);
+
+  tweakey_t tk1 = load_tk(st->arr + 16);
+  tweakey_t tk2 = load_tk(st->arr + 32);
+
+  for (size_t i = 0; i < skinny::ROUNDS; i++) {
+    round(row, tk1.lo ^ tk2.lo ^ load_rows(ks->rtk3[i]), i);
+
+    permute_tk(tk1);
+    permute_tk(tk2);
+
+    tk2.lo = tk2_lfsr(tk2.lo);
+  }
+
+  store_state(row, st);
+  store_tk(tk1, st->arr + 16);
+  store_tk(tk2, st->arr + 32);
+}
+
+// Computes round tweakey contributions of tweakey state (2), for all 40
+// rounds, combined with already expanded round tweakeys of tweakey state (3),
+// same as skinny::expand_tk2 does
+inline static void expand_tk2(
+    skinny::tweakey_schedule_t* const __restrict ts,   // 40 rounds of TK2 ^ TK3
+    const uint8_t* const __restrict tk2,               // 16 -bytes TK2
+    const skinny::key_schedule_t* const __restrict ks  // 40 rounds of TK3
+) {
+  tweakey_t tk = load_tk(tk2);
+
+  for (size_t r = 0; r < skinny::ROUNDS; r++) {
+    store_rows(tk.lo ^ load_rows(ks->rtk3[r]), ts->rtk23[r]);
+
+    permute_tk(tk);
+    tk.lo = tk2_lfsr(tk.lo);
+  }
+}
+
+// Skinny-128-384+ tweakable block cipher with 40 rounds, where tweakey state
+// (2, 3) are already expanded into combined round tweakeys, using
+// skinny::expand_tk2 routine, producing same internal state and tweakey state
+// (1) as skinny::tbc does. Only first 32 -bytes of state array are used.
+inline static void tbc(skinny::state_t* const __restrict st,
+                       const skinny::tweakey_schedule_t* const __restrict ts) {
+  uint32_t row[4];
+  load_state(st, row);
+
+  tweakey_t tk1 = load_tk(st->arr + 16);
+
+  for (size_t i = 0; i < skinny::ROUNDS; i++) {
+    round(row, tk1.lo ^ load_rows(ts->rtk23[i]), i);
+    permute_tk(tk1);
+  }
+
+  store_state(row, st);
+  store_tk(tk1, st->arr + 16);
+}
+
+// Skinny-128-384+ tweakable block cipher with 40 rounds, encrypting two
+// independent states, each under its own tweakey state (1, 2), while sharing
+// round tweakeys of tweakey state (3), see skinny::tbc_pair
+inline static void tbc_pair(skinny::state_t* const __restrict st0,
+                            skinny::state_t* const __restrict st1,
+                            const skinny::key_schedule_t* const __restrict ks) {
+  uint32_t row0[4];
+  uint32_t row1[4];
+
+  load_state(st0, row0);
+  load_state(st1, row1);
+
+  tweakey_t tk1[2] = {load_tk(st0->arr + 16), load_tk(st1->arr + 16)};
+  tweakey_t tk2[2] = {load_tk(st0->arr + 32), load_tk(st1->arr + 32)};
+
+  for (size_t i = 0; i < skinny::ROUNDS; i++) {
+    const uint64_t rtk3 = load_rows(ks->rtk3[i]);
+
+    round(row0, tk1[0].lo ^ tk2[0].lo ^ rtk3, i);
+    round(row1, tk1[1].lo ^ tk2[1].lo ^ rtk3, i);
+
+    for (size_t j = 0; j < 2; j++) {
+      permute_tk(tk1[j]);
+      permute_tk(tk2[j]);
+
+      tk2[j].lo = tk2_lfsr(tk2[j].lo);
+    }
+  }
+
+  store_state(row0, st0);
+  store_state(row1, st1);
+
+  store_tk(tk1[0], st0->arr + 16);
+  store_tk(tk2[0], st0->arr + 32);
+  store_tk(tk1[1], st1->arr + 16);
+  store_tk(tk2[1], st1->arr + 32);
+}
+
+// Skinny-128-384+ tweakable block cipher with 40 rounds, encrypting internal
+// state of `st` and another 16 -bytes block `blk`, both under tweakey state of
+// `st`, see skinny::tbc2
+inline static void tbc2(skinny::state_t* const __restrict st,
+                        uint8_t* const __restrict blk) {
+  uint32_t row0[4];
+  uint32_t row1[4];
+
+  load_state(st, row0);
+  for (size_t i = 0; i < 4; i++) {
+    row1[i] = load_row(blk + (i << 2));
+  }
+
+  tweakey_t tk1 = load_tk(st->arr + 16);
+  tweakey_t tk2 = load_tk(st->arr + 32);
+  tweakey_t tk3 = load_tk(st->arr + 48);
+
+  for (size_t i = 0; i < skinny::ROUNDS; i++) {
+    const uint64_t rtk = tk1.lo ^ tk2.lo ^ tk3.lo;
+
+    round(row0, rtk, i);
+    round(row1, rtk, i);
+
+    permute_tk(tk1);
+    permute_tk(tk2);
+    permute_tk(tk3);
+
+    tk2.lo = tk2_lfsr(tk2.lo);
+    tk3.lo = tk3_lfsr(tk3.lo);
+  }
+
+  store_state(row0, st);
+  for (size_t i = 0; i < 4; i++) {
+    store_row(row1[i], blk + (i << 2));
+  }
+
+  store_tk(tk1, st->arr + 16);
+  store_tk(tk2, st->arr + 32);
+  store_tk(tk3, st->arr + 48);
+}
+
+// Skinny-128-384+ tweakable block cipher with 40 rounds, encrypting internal
+// state of `st` under its tweakey and under same tweakey, with tweakey state
+// (1) replaced by `tk1`, writing latter result to `blk`, see skinny::tbc2_tk1
+inline static void tbc2_tk1(skinny::state_t* const __restrict st,
+                            const uint8_t* const __restrict tk1,
+                            uint8_t* const __restrict blk) {
+  uint32_t row0[4];
+  uint32_t row1[4];
+
+  load_state(st, row0);
+  std::memcpy(row1, row0, sizeof(row0));
+
+  tweakey_t tk1_ = load_tk(st->arr + 16);
+  tweakey_t tk2 = load_tk(st->arr + 32);
+  tweakey_t tk3 = load_tk(st->arr + 48);
+
+  // tweakey state (1) of both tweakeys differ by `diff`, which is only permuted
+  tweakey_t diff = load_tk(tk1);
+  diff.lo ^= tk1_.lo;
+  diff.hi ^= tk1_.hi;
+
+  for (size_t i = 0; i < skinny::ROUNDS; i++) {
+    const uint64_t rtk = tk1_.lo ^ tk2.lo ^ tk3.lo;
+
+    round(row0, rtk, i);
+    round(row1, rtk ^ diff.lo, i);
+
+    permute_tk(tk1_);
+    permute_tk(tk2);
+    permute_tk(tk3);
+    permute_tk(diff);
+
+    tk2.lo = tk2_lfsr(tk2.lo);
+    tk3.lo = tk3_lfsr(tk3.lo);
+  }
+
+  store_state(row0, st);
+  for (size_t i = 0; i < 4; i++) {
+    store_row(row1[i], blk + (i << 2));
+  }
+
+  store_tk(tk1_, st->arr + 16);
+  store_tk(tk2, st->arr + 32);
+  store_tk(tk3, st->arr + 48);
+}
+
+}  // namespace skinny_rows
@@ -0,0 +1,935 @@
+#pragma once
+#include "skinny.hpp"
+#include "skinny_rows.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SKINNY_SIMD_X86
+#include <immintrin.h>
+#endif
+
+// Vectorized Skinny-128-384+ Tweakable Block Cipher, where implementation is
+// picked at run time, based on instruction set extensions supported by CPU
+namespace skinny_simd {
+
+#if defined(SKINNY_SIMD_X86)
+
+// Byte shuffle control vector for applying `ShiftRows` routine on internal
+// state, held in a 128 -bit register
+//
+// See section 2.3 of Romulus specification
+// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/romulus-spec-final.pdf
+alignas(16) constexpr uint8_t SR[16] = {0,  1,  2,  3,  7,  4,  5,  6,
+                                        10, 11, 8,  9,  13, 14, 15, 12};
+
+// Round constants of skinny::RC_CELLS, laid out such that they can be added to
+// first column of internal state, using a single 128 -bit XOR
+alignas(16) constexpr auto RC = []() {
+  struct {
+    uint8_t arr[skinny::ROUNDS][16];
+  } rc{};
+
+  for (size_t i = 0; i < skinny::ROUNDS; i++) {
+    rc.arr[i][0] = skinny::RC_CELLS.arr[i][0];
+    rc.arr[i][4] = skinny::RC_CELLS.arr[i][1];
+    rc.arr[i][8] = 0x02;
+  }
+
+  return rc;
+}();
+
+// Substitutes cells of internal state by applying 8 -bit Sbox, where Sbox is
+// decomposed into sixteen 16 -entry tables, indexed by low nibble of each cell,
+// while high nibble of cell selects which table's output to keep. Two such
+// tables are looked up per `vpshufb` instruction.
+__attribute__((target("avx2"))) inline static __m128i sub_cells_avx2(
+    const __m128i s) {
+  const __m128i mask = _mm_set1_epi8(0x0f);
+
+  const __m128i lo = _mm_and_si128(s, mask);
+  const __m128i hi = _mm_and_si128(_mm_srli_epi16(s, 4), mask);
+
+  const __m256i lo2 = _mm256_broadcastsi128_si256(lo);
+  const __m256i hi2 = _mm256_broadcastsi128_si256(hi);
+
+  const __m256i two = _mm256_set1_epi8(2);
+
+  __m256i row = _mm256_set_m128i(_mm_set1_epi8(1), _mm_set1_epi8(0));
+  __m256i acc = _mm256_setzero_si256();
+
+  for (size_t i = 0; i < 8; i++) {
+    const auto ptr = reinterpret_cast<const __m256i*>(skinny::S8 + (i << 5));
+
+    const __m256i tab = _mm256_loadu_si256(ptr);
+    const __m256i val = _mm256_shuffle_epi8(tab, lo2);
+    const __m256i sel = _mm256_cmpeq_epi8(hi2, row);
+
+    acc = _mm256_or_si256(acc, _mm256_and_si256(val, sel));
+    row = _mm256_add_epi8(row, two);
+  }
+
+  const __m128i acc0 = _mm256_castsi256_si128(acc);
+  const __m128i acc1 = _mm256_extracti128_si256(acc, 1);
+
+  return _mm_or_si128(acc0, acc1);
+}
+
+// Substitutes cells of ( upto four ) internal states by applying 8 -bit Sbox,
+// where whole 256 -entry Sbox is kept in four 512 -bit registers, such that
+// lower and upper halves of Sbox are looked up using two `vpermi2b`
+// instructions, from which right output is selected by most significant bit of
+// each cell.
+__attribute__((target("avx512f,avx512bw,avx512vbmi"))) inline static __m512i
+sub_cells_avx512(const __m512i idx, const __m512i* const __restrict tab) {
+  const __m512i lo = _mm512_permutex2var_epi8(tab[0], idx, tab[1]);
+  const __m512i hi = _mm512_permutex2var_epi8(tab[2], idx, tab[3]);
+  const __mmask64 sel = _mm512_movepi8_mask(idx);
+
+  return _mm512_mask_blend_epi8(sel, lo, hi);
+}
+
+// Substitutes cells of internal state by applying 8 -bit Sbox, using above
+// routine, where internal state is kept in lowest 128 -bit lane
+__attribute__((target("avx512f,avx512bw,avx512vbmi"))) inline static __m128i
+sub_cells_avx512(const __m128i s, const __m512i* const __restrict tab) {
+  const __m512i res = sub_cells_avx512(_mm512_zextsi128_si512(s), tab);
+
+  // same as _mm512_castsi512_si128, which trips -Wuninitialized with GCC 12
+  return _mm_set_epi64x(res[1], res[0]);
+}
+
+// Vectorized form of skinny::tk2_lfsr, applied on lower 8 cells ( i.e. first
+// two rows ) of tweakey state (2)
+__attribute__((target("avx2"))) inline static __m128i tk2_lfsr(
+    const __m128i x) {
+  const __m128i a = _mm_and_si128(_mm_slli_epi16(x, 1), _mm_set1_epi8(-2));
+  const __m128i b = _mm_xor_si128(_mm_srli_epi16(x, 7), _mm_srli_epi16(x, 5));
+  const __m128i y = _mm_or_si128(a, _mm_and_si128(b, _mm_set1_epi8(1)));
+
+  return _mm_blend_epi32(y, x, 0b1100);
+}
+
+// Vectorized form of skinny::tk3_lfsr, applied on lower 8 cells ( i.e. first
+// two rows ) of tweakey state (3)
+__attribute__((target("avx2"))) inline static __m128i tk3_lfsr(
+    const __m128i x) {
+  const __m128i a = _mm_xor_si128(_mm_slli_epi16(x, 7), _mm_slli_epi16(x, 1));
+  const __m128i b = _mm_and_si128(_mm_srli_epi16(x, 1), _mm_set1_epi8(0x7f));
+  const __m128i y = _mm_or_si128(_mm_and_si128(a, _mm_set1_epi8(-128)), b);
+
+  return _mm_blend_epi32(y, x, 0b1100);
+}
+
+// Same as above `tk2_lfsr`, applied on tweakey states (2) of two independent
+// tweakeys, one in each 128 -bit lane
+__attribute__((target("avx2"))) inline static __m256i tk2_lfsr(
+    const __m256i x) {
+  const __m256i a =
+      _mm256_and_si256(_mm256_slli_epi16(x, 1), _mm256_set1_epi8(-2));
+  const __m256i b =
+      _mm256_xor_si256(_mm256_srli_epi16(x, 7), _mm256_srli_epi16(x, 5));
+  const __m256i y =
+      _mm256_or_si256(a, _mm256_and_si256(b, _mm256_set1_epi8(1)));
+
+  return _mm256_blend_epi32(y, x, 0b11001100);
+}
+
+// Same as above `tk3_lfsr`, applied on tweakey states (3) of two independent
+// tweakeys, one in each 128 -bit lane
+__attribute__((target("avx2"))) inline static __m256i tk3_lfsr(
+    const __m256i x) {
+  const __m256i a =
+      _mm256_xor_si256(_mm256_slli_epi16(x, 7), _mm256_slli_epi16(x, 1));
+  const __m256i b =
+      _mm256_and_si256(_mm256_srli_epi16(x, 1), _mm256_set1_epi8(0x7f));
+  const __m256i y =
+      _mm256_or_si256(_mm256_and_si256(a, _mm256_set1_epi8(-128)), b);
+
+  return _mm256_blend_epi32(y, x, 0b11001100);
+}
+
+// Multiplies each column of internal state with binary matrix M, where each
+// row of internal state is a 32 -bit lane of the register
+__attribute__((target("avx2"))) inline static __m128i mix_columns(
+    const __m128i s) {
+  const __m128i a = _mm_shuffle_epi32(s, _MM_SHUFFLE(0, 1, 0, 0));
+  const __m128i b = _mm_shuffle_epi32(s, _MM_SHUFFLE(2, 2, 2, 2));
+  const __m128i c = _mm_srli_si128(s, 12);
+
+  const __m128i b_ = _mm_blend_epi32(b, _mm_setzero_si128(), 0b0010);
+  return _mm_xor_si128(_mm_xor_si128(a, b_), c);
+}
+
+// Computes round tweakey ( along with round constants ) to be added to internal
+// state, while updating all three tweakey states by applying permutation P_T
+// and LFSRs, for round `r_idx`
+__attribute__((target("avx2"))) inline static __m128i round_tweakey(
+    __m128i* const __restrict tk, const size_t r_idx) {
+  const auto rc = reinterpret_cast<const __m128i*>(RC.arr[r_idx]);
+  const auto pt = reinterpret_cast<const __m128i*>(skinny::P_T);
+
+  const __m128i rtk = _mm_xor_si128(_mm_xor_si128(tk[0], tk[1]), tk[2]);
+  const __m128i rk = _mm_xor_si128(_mm_move_epi64(rtk), _mm_load_si128(rc));
+
+  const __m128i pt_ = _mm_loadu_si128(pt);
+
+  tk[0] = _mm_shuffle_epi8(tk[0], pt_);
+  tk[1] = tk2_lfsr(_mm_shuffle_epi8(tk[1], pt_));
+  tk[2] = tk3_lfsr(_mm_shuffle_epi8(tk[2], pt_));
+
+  return rk;
+}
+
+// Same as above `round_tweakey`, except contribution of tweakey state (3) is
+// taken from precomputed round tweakeys, so only tweakey state (1, 2) are
+// updated
+__attribute__((target("avx2"))) inline static __m128i round_tweakey(
+    __m128i* const __restrict tk, const uint8_t* const __restrict rtk3,
+    const size_t r_idx) {
+  const auto rc = reinterpret_cast<const __m128i*>(RC.arr[r_idx]);
+  const auto pt = reinterpret_cast<const __m128i*>(skinny::P_T);
+
+  const __m128i tk3 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(rtk3));
+  const __m128i rtk = _mm_xor_si128(_mm_xor_si128(tk[0], tk[1]), tk3);
+  const __m128i rk = _mm_xor_si128(_mm_move_epi64(rtk), _mm_load_si128(rc));
+
+  const __m128i pt_ = _mm_loadu_si128(pt);
+
+  tk[0] = _mm_shuffle_epi8(tk[0], pt_);
+  tk[1] = tk2_lfsr(_mm_shuffle_epi8(tk[1], pt_));
+
+  return rk;
+}
+
+// Same as above `round_tweakey`, except contribution of tweakey state (2, 3) is
+// taken from precomputed round tweakeys, so only tweakey state (1) is updated
+__attribute__((target("avx2"))) inline static __m128i round_tweakey_tk1(
+    __m128i* const __restrict tk1, const uint8_t* const __restrict rtk23,
+    const size_t r_idx) {
+  const auto rc = reinterpret_cast<const __m128i*>(RC.arr[r_idx]);
+  const auto pt = reinterpret_cast<const __m128i*>(skinny::P_T);
+
+  const __m128i tk23 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(rtk23));
+  const __m128i rtk = _mm_move_epi64(_mm_xor_si128(*tk1, tk23));
+  const __m128i rk = _mm_xor_si128(rtk, _mm_load_si128(rc));
+
+  *tk1 = _mm_shuffle_epi8(*tk1, _mm_loadu_si128(pt));
+
+  return rk;
+}
+
+// Adds round tweakey ( along with round constants ) to internal state, which is
+// followed by `ShiftRows` and `MixColumns`, finishing a round, whose `SubCells`
+// is expected to be applied by caller, because that's the only routine which
+// differs between AVX2 and AVX-512 implementations
+__attribute__((target("avx2"))) inline static __m128i finish_round(
+    const __m128i s, const __m128i rk) {
+  const auto sr = reinterpret_cast<const __m128i*>(SR);
+
+  const __m128i t = _mm_shuffle_epi8(_mm_xor_si128(s, rk), _mm_load_si128(sr));
+  return mix_columns(t);
+}
+
+// Skinny-128-384+ tweakable block cipher with 40 rounds, using AVX2 intrinsics
+__attribute__((target("avx2"))) inline static void tbc_avx2(
+    skinny::state_t* const __restrict st) {
+  const auto ptr = reinterpret_cast<__m128i*>(st->arr);
+
+  __m128i s = _mm_loadu_si128(ptr + 0);
+  __m128i tk[3] = {_mm_loadu_si128(ptr + 1), _mm_loadu_si128(ptr + 2),
+                   _mm_loadu_si128(ptr + 3)};
+
+  for (size_t i = 0; i < skinny::ROUNDS; i++) {
+    s = finish_round(sub_cells_avx2(s), round_tweakey(tk, i));
+  }
+
+  _mm_storeu_si128(ptr + 0, s);
+  _mm_storeu_si128(ptr + 1, tk[0]);
+  _mm_storeu_si128(ptr + 2, tk[1]);
+  _mm_storeu_si128(ptr + 3, tk[2]);
+}
+
+// Skinny-128-384+ tweakable block cipher with 40 rounds, using AVX-512
+// intrinsics ( requires AVX512F, AVX512BW and AVX512VBMI )
+__attribute__((target("avx2,avx512f,avx512bw,avx512vbmi"))) inline static void
+tbc_avx512(skinny::state_t* const __restrict st) {
+  const auto ptr = reinterpret_cast<__m128i*>(st->arr);
+  const auto sbox = reinterpret_cast<const __m512i*>(skinny::S8);
+
+  const __m512i tab[4] = {_mm512_loadu_si512(sbox + 0),
+                          _mm512_loadu_si512(sbox + 1),
+                          _mm512_loadu_si512(sbox + 2),
+                          _mm512_loadu_si512(sbox + 3)};
+
+  __m128i s = _mm_loadu_si128(ptr + 0);
+  __m128i tk[3] = {_mm_loadu_si128(ptr + 1), _mm_loadu_si128(ptr + 2),
+                   _mm_loadu_si128(ptr + 3)};
+
+  for (size_t i = 0; i < skinny::ROUNDS; i++) {
+    s = finish_round(sub_cells_avx512(s, tab), round_tweakey(tk, i));
+  }
+
+  _mm_storeu_si128(ptr + 0, s);
+  _mm_storeu_si128(ptr + 1, tk[0]);
+  _mm_storeu_si128(ptr + 2, tk[1]);
+  _mm_storeu_si128(ptr + 3, tk[2]);
+}
+
+// Skinny-128-384+ tweakable block cipher with 40 rounds, using AVX2 intrinsics,
+// where tweakey state (3) is already expanded into round tweakeys
+__attribute__((target("avx2"))) inline static void tbc_avx2(
+    skinny::state_t* const __restrict st,
+    const skinny::key_schedule_t* const __restrict ks) {
+  const auto ptr = reinterpret_cast<__m128i*>(st->arr);
+
+  __m128i s = _mm_loadu_si128(ptr + 0);
+  __m128i tk[2] = {_mm_loadu_si128(ptr + 1), _mm_loadu_si128(ptr + 2)};
+
+  for (size_t i = 0; i < skinny::ROUNDS; i++) {
+    const __m128i rk = round_tweakey(tk, ks->rtk3[i], i);
+    s = finish_round(sub_cells_avx2(s), rk);
+  }
+
+  _mm_storeu_si128(ptr + 0, s);
+  _mm_storeu_si128(ptr + 1, tk[0]);
+  _mm_storeu_si128(ptr + 2, tk[1]);
+}
+
+// Skinny-128-384+ tweakable block cipher with 40 rounds, using AVX-512
+// intrinsics, where tweakey state (3) is already expanded into round tweakeys
+__attribute__((target("avx2,avx512f,avx512bw,avx512vbmi"))) inline static void
+tbc_avx512(skinny::state_t* const __restrict st,
+           const skinny::key_schedule_t* const __restrict ks) {
+  const auto ptr = reinterpret_cast<__m128i*>(st->arr);
+  const auto sbox = reinterpret_cast<const __m512i*>(skinny::S8);
+
+  const __m512i tab[4] = {_mm512_loadu_si512(sbox + 0),
+                          _mm512_loadu_si512(sbox + 1),
+                          _mm512_loadu_si512(sbox + 2),
+                          _mm512_loadu_si512(sbox + 3)};
+
+  __m128i s = _mm_loadu_si128(ptr + 0);
+  __m128i tk[2] = {_mm_loadu_si128(ptr + 1), _mm_loadu_si128(ptr + 2)};
+
+  for (size_t i = 0; i < skinny::ROUNDS; i++) {
+    const __m128i rk = round_tweakey(tk, ks->rtk3[i], i);
+    s = finish_round(sub_cells_avx512(s, tab), rk);
+  }
+
+  _mm_storeu_si128(ptr + 0, s);
+  _mm_storeu_si128(ptr + 1, tk[0]);
+  _mm_storeu_si128(ptr + 2, tk[1]);
+}
+
+// Skinny-128-384+ tweakable block cipher with 40 rounds, using AVX2 intrinsics,
+// where tweakey state (2, 3) are already expanded into combined round tweakeys
+__attribute__((target("avx2"))) inline static void tbc_avx2(
+    skinny::state_t* const __restrict st,
+    const skinny::tweakey_schedule_t* const __restrict ts) {
+  const auto ptr = reinterpret_cast<__m128i*>(st->arr);
+
+  __m128i s = _mm_loadu_si128(ptr + 0);
+  __m128i tk1 = _mm_loadu_si128(ptr + 1);
+
+  for (size_t i = 0; i < skinny::ROUNDS; i++) {
+    const __m128i rk = round_tweakey_tk1(&tk1, ts->rtk23[i], i);
+    s = finish_round(sub_cells_avx2(s), rk);
+  }
+
+  _mm_storeu_si128(ptr + 0, s);
+  _mm_storeu_si128(ptr + 1, tk1);
+}
+
+// Skinny-128-384+ tweakable block cipher with 40 rounds, using AVX-512
+// intrinsics, where tweakey state (2, 3) are already expanded into combined
+// round tweakeys
+__attribute__((target("avx2,avx512f,avx512bw,avx512vbmi"))) inline static void
+tbc_avx512(skinny::state_t* const __restrict st,
+           const skinny::tweakey_schedule_t* const __restrict ts) {
+  const auto ptr = reinterpret_cast<__m128i*>(st->arr);
+  const auto sbox = reinterpret_cast<const __m512i*>(skinny::S8);
+
+  const __m512i tab[4] = {_mm512_loadu_si512(sbox + 0),
+                          _mm512_loadu_si512(sbox + 1),
+                          _mm512_loadu_si512(sbox + 2),
+                          _mm512_loadu_si512(sbox + 3)};
+
+  __m128i s = _mm_loadu_si128(ptr + 0);
+  __m128i tk1 = _mm_loadu_si128(ptr + 1);
+
+  for (size_t i = 0; i < skinny::ROUNDS; i++) {
+    const __m128i rk = round_tweakey_tk1(&tk1, ts->rtk23[i], i);
+    s = finish_round(sub_cells_avx512(s, tab), rk);
+  }
+
+  _mm_storeu_si128(ptr + 0, s);
+  _mm_storeu_si128(ptr + 1, tk1);
+}
+
+// Skinny-128-384+ tweakable block cipher with 40 rounds, using AVX2 intrinsics,
+// encrypting two independent states, each under its own tweakey state (1, 2),
+// while sharing precomputed round tweakeys of tweakey state (3)
+__attribute__((target("avx2"))) inline static void tbc_pair_avx2(
+    skinny::state_t* const __restrict st0,
+    skinny::state_t* const __restrict st1,
+    const skinny::key_schedule_t* const __restrict ks) {
+  const auto ptr0 = reinterpret_cast<__m128i*>(st0->arr);
+  const auto ptr1 = reinterpret_cast<__m128i*>(st1->arr);
+
+  __m128i s0 = _mm_loadu_si128(ptr0 + 0);
+  __m128i s1 = _mm_loadu_si128(ptr1 + 0);
+  __m128i tk0[2] = {_mm_loadu_si128(ptr0 + 1), _mm_loadu_si128(ptr0 + 2)};
+  __m128i tk1[2] = {_mm_loadu_si128(ptr1 + 1), _mm_loadu_si128(ptr1 + 2)};
+
+  for (size_t i = 0; i < skinny::ROUNDS; i++) {
+    const __m128i rk0 = round_tweakey(tk0, ks->rtk3[i], i);
+    const __m128i rk1 = round_tweakey(tk1, ks->rtk3[i], i);
+
+    s0 = finish_round(sub_cells_avx2(s0), rk0);
+    s1 = finish_round(sub_cells_avx2(s1), rk1);
+  }
+
+  _mm_storeu_si128(ptr0 + 0, s0);
+  _mm_storeu_si128(ptr0 + 1, tk0[0]);
+  _mm_storeu_si128(ptr0 + 2, tk0[1]);
+  _mm_storeu_si128(ptr1 + 0, s1);
+  _mm_storeu_si128(ptr1 + 1, tk1[0]);
+  _mm_storeu_si128(ptr1 + 2, tk1[1]);
+}
+
+// Skinny-128-384+ tweakable block cipher with 40 rounds, using AVX-512
+// intrinsics, encrypting two independent states, each under its own tweakey
+// state (1, 2), while sharing precomputed round tweakeys of tweakey state (3),
+// where Sbox is applied on both states using a single lookup
+__attribute__((target("avx2,avx512f,avx512bw,avx512vbmi"))) inline static void
+tbc_pair_avx512(skinny::state_t* const __restrict st0,
+                skinny::state_t* const __restrict st1,
+                const skinny::key_schedule_t* const __restrict ks) {
+  const auto ptr0 = reinterpret_cast<__m128i*>(st0->arr);
+  const auto ptr1 = reinterpret_cast<__m128i*>(st1->arr);
+  const auto sbox = reinterpret_cast<const __m512i*>(skinny::S8);
+
+  const __m512i tab[4] = {_mm512_loadu_si512(sbox + 0),
+                          _mm512_loadu_si512(sbox + 1),
+                          _mm512_loadu_si512(sbox + 2),
+                          _mm512_loadu_si512(sbox + 3)};
+
+  __m128i s0 = _mm_loadu_si128(ptr0 + 0);
+  __m128i s1 = _mm_loadu_si128(ptr1 + 0);
+  __m128i tk0[2] = {_mm_loadu_si128(ptr0 + 1), _mm_loadu_si128(ptr0 + 2)};
+  __m128i tk1[2] = {_mm_loadu_si128(ptr1 + 1), _mm_loadu_si128(ptr1 + 2)};
+
+  for (size_t i = 0; i < skinny::ROUNDS; i++) {
+    const __m512i idx = _mm512_inserti32x4(_mm512_zextsi128_si512(s0), s1, 1);
+    const __m512i res = sub_cells_avx512(idx, tab);
+
+    const __m128i rk0 = round_tweakey(tk0, ks->rtk3[i], i);
+    const __m128i rk1 = round_tweakey(tk1, ks->rtk3[i], i);
+
+    s0 = finish_round(_mm_set_epi64x(res[1], res[0]), rk0);
+    s1 = finish_round(_mm_set_epi64x(res[3], res[2]), rk1);
+  }
+
+  _mm_storeu_si128(ptr0 + 0, s0);
+  _mm_storeu_si128(ptr0 + 1, tk0[0]);
+  _mm_storeu_si128(ptr0 + 2, tk0[1]);
+  _mm_storeu_si128(ptr1 + 0, s1);
+  _mm_storeu_si128(ptr1 + 1, tk1[0]);
+  _mm_storeu_si128(ptr1 + 2, tk1[1]);
+}
+
+// Skinny-128-384+ tweakable block cipher with 40 rounds, using AVX2 intrinsics,
+// encrypting internal state of `st` and another 16 -bytes block `blk`, both
+// under tweakey state of `st`, such that round tweakeys are computed only once
+// and both blocks are processed in lockstep
+__attribute__((target("avx2"))) inline static void tbc2_avx2(
+    skinny::state_t* const __restrict st, uint8_t* const __restrict blk) {
+  const auto ptr = reinterpret_cast<__m128i*>(st->arr);
+  const auto bptr = reinterpret_cast<__m128i*>(blk);
+
+  __m128i s0 = _mm_loadu_si128(ptr + 0);
+  __m128i s1 = _mm_loadu_si128(bptr);
+  __m128i tk[3] = {_mm_loadu_si128(ptr + 1), _mm_loadu_si128(ptr + 2),
+                   _mm_loadu_si128(ptr + 3)};
+
+  for (size_t i = 0; i < skinny::ROUNDS; i++) {
+    const __m128i rk = round_tweakey(tk, i);
+
+    s0 = finish_round(sub_cells_avx2(s0), rk);
+    s1 = finish_round(sub_cells_avx2(s1), rk);
+  }
+
+  _mm_storeu_si128(ptr + 0, s0);
+  _mm_storeu_si128(bptr, s1);
+  _mm_storeu_si128(ptr + 1, tk[0]);
+  _mm_storeu_si128(ptr + 2, tk[1]);
+  _mm_storeu_si128(ptr + 3, tk[2]);
+}
+
+// Skinny-128-384+ tweakable block cipher with 40 rounds, using AVX-512
+// intrinsics, encrypting internal state of `st` and another 16 -bytes block
+// `blk`, both under tweakey state of `st`, where Sbox is applied on both blocks
+// using a single lookup
+__attribute__((target("avx2,avx512f,avx512bw,avx512vbmi"))) inline static void
+tbc2_avx512(skinny::state_t* const __restrict st,
+            uint8_t* const __restrict blk) {
+  const auto ptr = reinterpret_cast<__m128i*>(st->arr);
+  const auto bptr = reinterpret_cast<__m128i*>(blk);
+  const auto sbox = reinterpret_cast<const __m512i*>(skinny::S8);
+
+  const __m512i tab[4] = {_mm512_loadu_si512(sbox + 0),
+                          _mm512_loadu_si512(sbox + 1),
+                          _mm512_loadu_si512(sbox + 2),
+                          _mm512_loadu_si512(sbox + 3)};
+
+  __m128i s0 = _mm_loadu_si128(ptr + 0);
+  __m128i s1 = _mm_loadu_si128(bptr);
+  __m128i tk[3] = {_mm_loadu_si128(ptr + 1), _mm_loadu_si128(ptr + 2),
+                   _mm_loadu_si128(ptr + 3)};
+
+  for (size_t i = 0; i < skinny::ROUNDS; i++) {
+    const __m512i idx = _mm512_inserti32x4(_mm512_zextsi128_si512(s0), s1, 1);
+    const __m512i res = sub_cells_avx512(idx, tab);
+
+    const __m128i rk = round_tweakey(tk, i);
+
+    s0 = finish_round(_mm_set_epi64x(res[1], res[0]), rk);
+    s1 = finish_round(_mm_set_epi64x(res[3], res[2]), rk);
+  }
+
+  _mm_storeu_si128(ptr + 0, s0);
+  _mm_storeu_si128(bptr, s1);
+  _mm_storeu_si128(ptr + 1, tk[0]);
+  _mm_storeu_si128(ptr + 2, tk[1]);
+  _mm_storeu_si128(ptr + 3, tk[2]);
+}
+
+// Skinny-128-384+ tweakable block cipher with 40 rounds, using AVX2 intrinsics,
+// doing what two independent `tbc2_avx2` calls, on ( `st0`, `blk0` ) and
+// ( `st1`, `blk1` ), do, such that both of them are processed in lockstep and
+// their dependency chains overlap
+__attribute__((target("avx2"))) inline static void tbc2x2_avx2(
+    skinny::state_t* const __restrict st0, uint8_t* const __restrict blk0,
+    skinny::state_t* const __restrict st1, uint8_t* const __restrict blk1) {
+  const auto ptr0 = reinterpret_cast<__m128i*>(st0->arr);
+  const auto ptr1 = reinterpret_cast<__m128i*>(st1->arr);
+  const auto bptr0 = reinterpret_cast<__m128i*>(blk0);
+  const auto bptr1 = reinterpret_cast<__m128i*>(blk1);
+
+  __m128i s0 = _mm_loadu_si128(ptr0 + 0);
+  __m128i s1 = _mm_loadu_si128(bptr0);
+  __m128i s2 = _mm_loadu_si128(ptr1 + 0);
+  __m128i s3 = _mm_loadu_si128(bptr1);
+  __m128i tk0[3] = {_mm_loadu_si128(ptr0 + 1), _mm_loadu_si128(ptr0 + 2),
+                    _mm_loadu_si128(ptr0 + 3)};
+  __m128i tk1[3] = {_mm_loadu_si128(ptr1 + 1), _mm_loadu_si128(ptr1 + 2),
+                    _mm_loadu_si128(ptr1 + 3)};
+
+  for (size_t i = 0; i < skinny::ROUNDS; i++) {
+    const __m128i rk0 = round_tweakey(tk0, i);
+    const __m128i rk1 = round_tweakey(tk1, i);
+
+    s0 = finish_round(sub_cells_avx2(s0), rk0);
+    s1 = finish_round(sub_cells_avx2(s1), rk0);
+    s2 = finish_round(sub_cells_avx2(s2), rk1);
+    s3 = finish_round(sub_cells_avx2(s3), rk1);
+  }
+
+  _mm_storeu_si128(ptr0 + 0, s0);
+  _mm_storeu_si128(bptr0, s1);
+  _mm_storeu_si128(ptr0 + 1, tk0[0]);
+  _mm_storeu_si128(ptr0 + 2, tk0[1]);
+  _mm_storeu_si128(ptr0 + 3, tk0[2]);
+  _mm_storeu_si128(ptr1 + 0, s2);
+  _mm_storeu_si128(bptr1, s3);
+  _mm_storeu_si128(ptr1 + 1, tk1[0]);
+  _mm_storeu_si128(ptr1 + 2, tk1[1]);
+  _mm_storeu_si128(ptr1 + 3, tk1[2]);
+}
+
+// Skinny-128-384+ tweakable block cipher with 40 rounds, using AVX-512
+// intrinsics, doing what two independent `tbc2_avx512` calls, on ( `st0`,
+// `blk0` ) and ( `st1`, `blk1` ), do, where all four blocks are kept in a
+// single 512 -bit register, while both tweakey states are kept in 256 -bit
+// registers, such that each step of a round is applied on all of them at once
+__attribute__((target("avx2,avx512f,avx512bw,avx512vbmi"))) inline static void
+tbc2x2_avx512(skinny::state_t* const __restrict st0,
+              uint8_t* const __restrict blk0,
+              skinny::state_t* const __restrict st1,
+              uint8_t* const __restrict blk1) {
+  const auto ptr0 = reinterpret_cast<__m128i*>(st0->arr);
+  const auto ptr1 = reinterpret_cast<__m128i*>(st1->arr);
+  const auto bptr0 = reinterpret_cast<__m128i*>(blk0);
+  const auto bptr1 = reinterpret_cast<__m128i*>(blk1);
+  const auto sbox = reinterpret_cast<const __m512i*>(skinny::S8);
+  const auto pt = reinterpret_cast<const __m128i*>(skinny::P_T);
+  const auto sr = reinterpret_cast<const __m128i*>(SR);
+
+  const __m512i tab[4] = {_mm512_loadu_si512(sbox + 0),
+                          _mm512_loadu_si512(sbox + 1),
+                          _mm512_loadu_si512(sbox + 2),
+                          _mm512_loadu_si512(sbox + 3)};
+
+  const __m256i pt_ = _mm256_broadcastsi128_si256(_mm_loadu_si128(pt));
+  // zero masking variants are used for 512 -bit shuffles, because unmasked
+  // ones trip -Wuninitialized with GCC 12
+  const __m512i sr_ = _mm512_maskz_broadcast_i32x4(0xffff, _mm_load_si128(sr));
+
+  // lanes hold st0, blk0, st1 and blk1, in order
+  const __m256i lo = _mm256_set_m128i(_mm_loadu_si128(bptr0),
+                                      _mm_loadu_si128(ptr0 + 0));
+  const __m256i hi = _mm256_set_m128i(_mm_loadu_si128(bptr1),
+                                      _mm_loadu_si128(ptr1 + 0));
+
+  __m512i s = _mm512_mask_broadcast_i64x4(
+      _mm512_maskz_broadcast_i64x4(0x0f, lo), 0xf0, hi);
+
+  // lower lane holds tweakey state of st0, upper one that of st1
+  __m256i tk[3];
+  for (size_t i = 0; i < 3; i++) {
+    tk[i] = _mm256_set_m128i(_mm_loadu_si128(ptr1 + 1 + i),
+                             _mm_loadu_si128(ptr0 + 1 + i));
+  }
+
+  for (size_t i = 0; i < skinny::ROUNDS; i++) {
+    const auto rc = reinterpret_cast<const __m128i*>(RC.arr[i]);
+
+    const __m256i rtk = _mm256_xor_si256(_mm256_xor_si256(tk[0], tk[1]), tk[2]);
+    const __m256i rtk_ = _mm256_blend_epi32(rtk, _mm256_setzero_si256(), 0xcc);
+    const __m256i rk2 = _mm256_xor_si256(
+        rtk_, _mm256_broadcastsi128_si256(_mm_load_si128(rc)));
+
+    // round tweakey of st0 is added to first two lanes, that of st1 to last two
+    const __m512i rk = _mm512_maskz_broadcast_i64x4(0xff, rk2);
+    const __m512i rk4 =
+        _mm512_maskz_shuffle_i64x2(0xff, rk, rk, _MM_SHUFFLE(1, 1, 0, 0));
+
+    tk[0] = _mm256_shuffle_epi8(tk[0], pt_);
+    tk[1] = tk2_lfsr(_mm256_shuffle_epi8(tk[1], pt_));
+    tk[2] = tk3_lfsr(_mm256_shuffle_epi8(tk[2], pt_));
+
+    const __m512i t = sub_cells_avx512(s, tab);
+    const __m512i u = _mm512_shuffle_epi8(_mm512_xor_si512(t, rk4), sr_);
+
+    // same as `mix_columns`, on each 128 -bit lane
+    const __m512i a = _mm512_maskz_shuffle_epi32(0xffff, u, _MM_PERM_ABAA);
+    const __m512i b = _mm512_maskz_shuffle_epi32(0xdddd, u, _MM_PERM_CCCC);
+    const __m512i c = _mm512_bsrli_epi128(u, 12);
+
+    s = _mm512_ternarylogic_epi32(a, b, c, 0x96);
+  }
+
+  alignas(64) uint8_t res[64];
+  _mm512_store_si512(reinterpret_cast<__m512i*>(res), s);
+
+  std::memcpy(st0->arr, res + 0, 16);
+  std::memcpy(blk0, res + 16, 16);
+  std::memcpy(st1->arr, res + 32, 16);
+  std::memcpy(blk1, res + 48, 16);
+
+  for (size_t i = 0; i < 3; i++) {
+    _mm_storeu_si128(ptr0 + 1 + i, _mm256_castsi256_si128(tk[i]));
+    _mm_storeu_si128(ptr1 + 1 + i, _mm256_extracti128_si256(tk[i], 1));
+  }
+}
+
+// Skinny-128-384+ tweakable block cipher with 40 rounds, using AVX2 intrinsics,
+// encrypting internal state of `st` under its tweakey and under same tweakey,
+// with tweakey state (1) replaced by `tk1`, writing latter result to `blk`,
+// where both encryptions are processed in lockstep, see skinny::tbc2_tk1
+__attribute__((target("avx2"))) inline static void tbc2_tk1_avx2(
+    skinny::state_t* const __restrict st, const uint8_t* const __restrict tk1,
+    uint8_t* const __restrict blk) {
+  const auto ptr = reinterpret_cast<__m128i*>(st->arr);
+  const auto pt = reinterpret_cast<const __m128i*>(skinny::P_T);
+
+  __m128i s0 = _mm_loadu_si128(ptr + 0);
+  __m128i s1 = s0;
+  __m128i tk[3] = {_mm_loadu_si128(ptr + 1), _mm_loadu_si128(ptr + 2),
+                   _mm_loadu_si128(ptr + 3)};
+
+  const __m128i tk1_ = _mm_loadu_si128(reinterpret_cast<const __m128i*>(tk1));
+  const __m128i pt_ = _mm_loadu_si128(pt);
+
+  __m128i diff = _mm_xor_si128(tk[0], tk1_);
+
+  for (size_t i = 0; i < skinny::ROUNDS; i++) {
+    const __m128i rk0 = round_tweakey(tk, i);
+    const __m128i rk1 = _mm_xor_si128(rk0, _mm_move_epi64(diff));
+
+    diff = _mm_shuffle_epi8(diff, pt_);
+
+    s0 = finish_round(sub_cells_avx2(s0), rk0);
+    s1 = finish_round(sub_cells_avx2(s1), rk1);
+  }
+
+  _mm_storeu_si128(ptr + 0, s0);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(blk), s1);
+  _mm_storeu_si128(ptr + 1, tk[0]);
+  _mm_storeu_si128(ptr + 2, tk[1]);
+  _mm_storeu_si128(ptr + 3, tk[2]);
+}
+
+// Skinny-128-384+ tweakable block cipher with 40 rounds, using AVX-512
+// intrinsics, encrypting internal state of `st` under its tweakey and under
+// same tweakey, with tweakey state (1) replaced by `tk1`, writing latter result
+// to `blk`, where Sbox is applied on both blocks using a single lookup
+__attribute__((target("avx2,avx512f,avx512bw,avx512vbmi"))) inline static void
+tbc2_tk1_avx512(skinny::state_t* const __restrict st,
+                const uint8_t* const __restrict tk1,
+                uint8_t* const __restrict blk) {
+  const auto ptr = reinterpret_cast<__m128i*>(st->arr);
+  const auto pt = reinterpret_cast<const __m128i*>(skinny::P_T);
+  const auto sbox = reinterpret_cast<const __m512i*>(skinny::S8);
+
+  const __m512i tab[4] = {_mm512_loadu_si512(sbox + 0),
+                          _mm512_loadu_si512(sbox + 1),
+                          _mm512_loadu_si512(sbox + 2),
+                          _mm512_loadu_si512(sbox + 3)};
+
+  __m128i s0 = _mm_loadu_si128(ptr + 0);
+  __m128i s1 = s0;
+  __m128i tk[3] = {_mm_loadu_si128(ptr + 1), _mm_loadu_si128(ptr + 2),
+                   _mm_loadu_si128(ptr + 3)};
+
+  const __m128i tk1_ = _mm_loadu_si128(reinterpret_cast<const __m128i*>(tk1));
+  const __m128i pt_ = _mm_loadu_si128(pt);
+
+  __m128i diff = _mm_xor_si128(tk[0], tk1_);
+
+  for (size_t i = 0; i < skinny::ROUNDS; i++) {
+    const __m512i idx = _mm512_inserti32x4(_mm512_zextsi128_si512(s0), s1, 1);
+    const __m512i res = sub_cells_avx512(idx, tab);
+
+    const __m128i rk0 = round_tweakey(tk, i);
+    const __m128i rk1 = _mm_xor_si128(rk0, _mm_move_epi64(diff));
+
+    diff = _mm_shuffle_epi8(diff, pt_);
+
+    s0 = finish_round(_mm_set_epi64x(res[1], res[0]), rk0);
+    s1 = finish_round(_mm_set_epi64x(res[3], res[2]), rk1);
+  }
+
+  _mm_storeu_si128(ptr + 0, s0);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(blk), s1);
+  _mm_storeu_si128(ptr + 1, tk[0]);
+  _mm_storeu_si128(ptr + 2, tk[1]);
+  _mm_storeu_si128(ptr + 3, tk[2]);
+}
+
+#endif
+
+// Signature of Skinny-128-384+ tweakable block cipher implementations
+using tbc_t = void (*)(skinny::state_t* const __restrict);
+
+// Signature of Skinny-128-384+ tweakable block cipher implementations, which
+// consume precomputed round tweakeys of tweakey state (3)
+using tbc_ks_t = void (*)(skinny::state_t* const __restrict,
+                          const skinny::key_schedule_t* const __restrict);
+
+// Signature of Skinny-128-384+ tweakable block cipher implementations, which
+// consume precomputed round tweakeys of tweakey state (2, 3)
+using tbc_ts_t = void (*)(skinny::state_t* const __restrict,
+                          const skinny::tweakey_schedule_t* const __restrict);
+
+// Signature of Skinny-128-384+ tweakable block cipher implementations, which
+// encrypt two independent states, sharing round tweakeys of tweakey state (3)
+using tbc_pair_t = void (*)(skinny::state_t* const __restrict,
+                            skinny::state_t* const __restrict,
+                            const skinny::key_schedule_t* const __restrict);
+
+// Signature of Skinny-128-384+ tweakable block cipher implementations, which
+// encrypt two blocks under same tweakey
+using tbc2_t = void (*)(skinny::state_t* const __restrict,
+                        uint8_t* const __restrict);
+
+// Signature of Skinny-128-384+ tweakable block cipher implementations, which
+// do what two independent `tbc2` calls do, in lockstep
+using tbc2x2_t = void (*)(skinny::state_t* const __restrict,
+                          uint8_t* const __restrict,
+                          skinny::state_t* const __restrict,
+                          uint8_t* const __restrict);
+
+// Signature of Skinny-128-384+ tweakable block cipher implementations, which
+// encrypt same block under two tweakeys, differing only in tweakey state (1)
+using tbc2_tk1_t = void (*)(skinny::state_t* const __restrict,
+                            const uint8_t* const __restrict,
+                            uint8_t* const __restrict);
+
+// Instruction set extensions, which vectorized implementations can make use of
+enum class isa_t { portable, avx2, avx512 };
+
+// Picks fastest instruction set extension, supported by CPU on which this code
+// is being executed, falling back to portable implementation ( see
+// skinny_rows.hpp ), if none of vectorized implementations can be used
+inline static isa_t select() {
+#if defined(SKINNY_SIMD_X86)
+  __builtin_cpu_init();
+
+  const bool avx512 = __builtin_cpu_supports("avx512f") &&
+                      __builtin_cpu_supports("avx512bw") &&
+                      __builtin_cpu_supports("avx512vbmi");
+
+  if (avx512) {
+    return isa_t::avx512;
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    return isa_t::avx2;
+  }
+#endif
+
+  return isa_t::portable;
+}
+
+// Returns instruction set extension chosen ( only once ) by `select` routine,
+// for being used by run time dispatcher
+inline static isa_t isa() {
+  static const isa_t impl = select();
+  return impl;
+}
+
+// Checks whether implementations using given instruction set extension can be
+// executed on this CPU, where each of them also supports narrower ones, which
+// precede it in `isa_t`
+inline static bool supports(const isa_t ext) {
+  return static_cast<int>(ext) <= static_cast<int>(isa());
+}
+
+// Skinny-128-384+ tweakable block cipher with 40 rounds, dispatching to
+// fastest implementation supported by CPU
+inline static void tbc(skinny::state_t* const __restrict st) {
+  switch (isa()) {
+#if defined(SKINNY_SIMD_X86)
+    case isa_t::avx512:
+      tbc_avx512(st);
+      return;
+    case isa_t::avx2:
+      tbc_avx2(st);
+      return;
+#endif
+    default:
+      skinny_rows::tbc(st);
+  }
+}
+
+// Skinny-128-384+ tweakable block cipher with 40 rounds, consuming precomputed
+// round tweakeys of tweakey state (3), dispatching to fastest implementation
+// supported by CPU
+inline static void tbc(skinny::state_t* const __restrict st,
+                       const skinny::key_schedule_t* const __restrict ks) {
+  switch (isa()) {
+#if defined(SKINNY_SIMD_X86)
+    case isa_t::avx512:
+      tbc_avx512(st, ks);
+      return;
+    case isa_t::avx2:
+      tbc_avx2(st, ks);
+      return;
+#endif
+    default:
+      skinny_rows::tbc(st, ks);
+  }
+}
+
+// Skinny-128-384+ tweakable block cipher with 40 rounds, consuming precomputed
+// round tweakeys of tweakey state (2, 3), dispatching to fastest implementation
+// supported by CPU
+inline static void tbc(skinny::state_t* const __restrict st,
+                       const skinny::tweakey_schedule_t* const __restrict ts) {
+  switch (isa()) {
+#if defined(SKINNY_SIMD_X86)
+    case isa_t::avx512:
+      tbc_avx512(st, ts);
+      return;
+    case isa_t::avx2:
+      tbc_avx2(st, ts);
+      return;
+#endif
+    default:
+      skinny_rows::tbc(st, ts);
+  }
+}
+
+// Skinny-128-384+ tweakable block cipher with 40 rounds, encrypting two
+// independent states, each under its own tweakey state (1, 2), while sharing
+// precomputed round tweakeys of tweakey state (3), dispatching to fastest
+// implementation supported by CPU
+inline static void tbc_pair(skinny::state_t* const __restrict st0,
+                            skinny::state_t* const __restrict st1,
+                            const skinny::key_schedule_t* const __restrict ks) {
+  switch (isa()) {
+#if defined(SKINNY_SIMD_X86)
+    case isa_t::avx512:
+      tbc_pair_avx512(st0, st1, ks);
+      return;
+    case isa_t::avx2:
+      tbc_pair_avx2(st0, st1, ks);
+      return;
+#endif
+    default:
+      skinny_rows::tbc_pair(st0, st1, ks);
+  }
+}
+
+// Skinny-128-384+ tweakable block cipher with 40 rounds, encrypting internal
+// state of `st` and another 16 -bytes block `blk`, both under tweakey state of
+// `st`, dispatching to fastest implementation supported by CPU
+inline static void tbc2(skinny::state_t* const __restrict st,
+                        uint8_t* const __restrict blk) {
+  switch (isa()) {
+#if defined(SKINNY_SIMD_X86)
+    case isa_t::avx512:
+      tbc2_avx512(st, blk);
+      return;
+    case isa_t::avx2:
+      tbc2_avx2(st, blk);
+      return;
+#endif
+    default:
+      skinny_rows::tbc2(st, blk);
+  }
+}
+
+// Skinny-128-384+ tweakable block cipher with 40 rounds, doing what two
+// independent `tbc2` calls, on ( `st0`, `blk0` ) and ( `st1`, `blk1` ), do,
+// dispatching to fastest implementation supported by CPU
+inline static void tbc2x2(skinny::state_t* const __restrict st0,
+                          uint8_t* const __restrict blk0,
+                          skinny::state_t* const __restrict st1,
+                          uint8_t* const __restrict blk1) {
+  switch (isa()) {
+#if defined(SKINNY_SIMD_X86)
+    case isa_t::avx512:
+      tbc2x2_avx512(st0, blk0, st1, blk1);
+      return;
+    case isa_t::avx2:
+      tbc2x2_avx2(st0, blk0, st1, blk1);
+      return;
+#endif
+    default:
+      skinny_rows::tbc2(st0, blk0);
+      skinny_rows::tbc2(st1, blk1);
+  }
+}
+
+// Skinny-128-384+ tweakable block cipher with 40 rounds, encrypting internal
+// state of `st` under its tweakey and under same tweakey, with tweakey state
+// (1) replaced by `tk1`, writing latter result to `blk`, dispatching to fastest
+// implementation supported by CPU
+inline static void tbc2_tk1(skinny::state_t* const __restrict st,
+                            const uint8_t* const __restrict tk1,
+                            uint8_t* const __restrict blk) {
+  switch (isa()) {
+#if defined(SKINNY_SIMD_X86)
+    case isa_t::avx512:
+      tbc2_tk1_avx512(st, tk1, blk);
+      return;
+    case isa_t::avx2:
+      tbc2_tk1_avx2(st, tk1, blk);
+      return;
+#endif
+    default:
+      skinny_rows::tbc2_tk1(st, tk1, blk);
+  }
+}
+
+}  // namespace skinny_simd
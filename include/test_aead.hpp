@@ -0,0 +1,834 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <vector>
+
+#include "romulusm.hpp"
+#include "romulusn.hpp"
+#include "romulust.hpp"
+#include "segmented.hpp"
+#include "utils.hpp"
+
+// Test functional correctness of Romulus AEAD/ Hash functions
+namespace test_romulus {
+
+// Tests that packed 56 -bit LFSR, when stepped, goes through same sequence of
+// values as byte array form of it does, while jumping ahead by N steps lands on
+// same value as stepping N -many times
+static void romulus_lfsr() {
+  constexpr size_t steps = 1ul << 16;
+
+  uint8_t lfsr[7];
+  uint8_t packed[7];
+
+  romulus_common::set_lfsr(lfsr);
+  uint64_t v = romulus_common::LFSR_INIT;
+
+  for (size_t i = 0; i < steps; i++) {
+    romulus_common::store_lfsr(v, packed);
+    for (size_t j = 0; j < 7; j++) {
+      assert((lfsr[j] ^ packed[j]) == 0);
+    }
+
+    const uint64_t w = romulus_common::jump_lfsr(romulus_common::LFSR_INIT, i);
+    assert(v == w);
+
+    romulus_common::update_lfsr(lfsr);
+    v = romulus_common::step_lfsr(v);
+  }
+
+  // jumps compose, even for step counts far beyond what's stepped above
+  constexpr uint64_t n0 = 0x0123456789abcdeful;
+  constexpr uint64_t n1 = 0x00fedcba98765432ul;
+
+  uint8_t r[8];
+  random_data(r, sizeof(r));
+
+  uint64_t x = 0;
+  for (size_t i = 0; i < sizeof(r); i++) {
+    x = (x << 8) | r[i];
+  }
+  x &= romulus_common::LFSR_MASK;
+
+  const uint64_t a = romulus_common::jump_lfsr(x, n0 + n1);
+  const uint64_t b = romulus_common::jump_lfsr(x, n0);
+  const uint64_t c = romulus_common::jump_lfsr(b, n1);
+  assert(a == c);
+}
+
+// Tests that Romulus-N encryption/ decryption, using a context prepared once
+// per key, computes same cipher text and tag as the routines taking raw secret
+// key do, while also checking that tampered tag is rejected
+static void romulusn_context() {
+  constexpr size_t knt = 16;
+  constexpr size_t max_dlen = 80;
+  constexpr size_t max_ctlen = 80;
+
+  uint8_t key[knt];
+  uint8_t nonce[knt];
+  uint8_t tag0[knt];
+  uint8_t tag1[knt];
+
+  random_data(key, knt);
+
+  romulusn::context_t ctx;
+  romulusn::setup(&ctx, key);
+
+  std::vector<uint8_t> data(max_dlen);
+  std::vector<uint8_t> txt(max_ctlen);
+  std::vector<uint8_t> enc0(max_ctlen);
+  std::vector<uint8_t> enc1(max_ctlen);
+  std::vector<uint8_t> dec(max_ctlen);
+
+  for (size_t dlen = 0; dlen < max_dlen; dlen += 7) {
+    for (size_t ctlen = 0; ctlen < max_ctlen; ctlen += 5) {
+      random_data(nonce, knt);
+      random_data(data.data(), dlen);
+      random_data(txt.data(), ctlen);
+
+      romulusn::encrypt(key, nonce, data.data(), dlen, txt.data(), enc0.data(),
+                        ctlen, tag0);
+      romulusn::encrypt(&ctx, nonce, data.data(), dlen, txt.data(),
+                        enc1.data(), ctlen, tag1);
+
+      for (size_t i = 0; i < ctlen; i++) {
+        assert((enc0[i] ^ enc1[i]) == 0);
+      }
+      for (size_t i = 0; i < knt; i++) {
+        assert((tag0[i] ^ tag1[i]) == 0);
+      }
+
+      bool f = false;
+      f = romulusn::decrypt(&ctx, nonce, tag1, data.data(), dlen, enc1.data(),
+                            dec.data(), ctlen);
+      assert(f);
+
+      for (size_t i = 0; i < ctlen; i++) {
+        assert((txt[i] ^ dec[i]) == 0);
+      }
+
+      tag1[0] ^= 1;
+      f = romulusn::decrypt(&ctx, nonce, tag1, data.data(), dlen, enc1.data(),
+                            dec.data(), ctlen);
+      assert(!f);
+    }
+  }
+}
+
+// Feeds N -bytes input to given incremental routine, in randomly sized chunks
+template<typename F>
+static void feed_in_chunks(const size_t len, F&& update) {
+  size_t off = 0;
+
+  while (off < len) {
+    uint8_t r;
+    random_data(&r, 1);
+
+    const size_t chunk = std::min<size_t>(r % 41, len - off);
+    update(off, chunk);
+    off += chunk;
+  }
+}
+
+// Tests that incremental Romulus-N encryption/ decryption, fed with randomly
+// sized chunks of associated data and plain/ cipher text, computes same cipher
+// text and tag as one-shot routines do
+static void romulusn_stream() {
+  constexpr size_t knt = 16;
+  constexpr size_t max_dlen = 100;
+  constexpr size_t max_ctlen = 100;
+
+  uint8_t key[knt];
+  uint8_t nonce[knt];
+  uint8_t tag0[knt];
+  uint8_t tag1[knt];
+
+  random_data(key, knt);
+
+  romulusn::context_t ctx;
+  romulusn::setup(&ctx, key);
+
+  std::vector<uint8_t> data(max_dlen);
+  std::vector<uint8_t> txt(max_ctlen);
+  std::vector<uint8_t> enc0(max_ctlen);
+  std::vector<uint8_t> enc1(max_ctlen);
+  std::vector<uint8_t> dec(max_ctlen);
+
+  for (size_t dlen = 0; dlen < max_dlen; dlen += 3) {
+    for (size_t ctlen = 0; ctlen < max_ctlen; ctlen += 3) {
+      random_data(nonce, knt);
+      random_data(data.data(), dlen);
+      random_data(txt.data(), ctlen);
+
+      romulusn::encrypt(&ctx, nonce, data.data(), dlen, txt.data(),
+                        enc0.data(), ctlen, tag0);
+
+      romulusn::stream_t strm;
+
+      romulusn::init(&strm, &ctx, nonce);
+      feed_in_chunks(dlen, [&](const size_t off, const size_t len) {
+        romulusn::absorb_ad(&strm, data.data() + off, len);
+      });
+      feed_in_chunks(ctlen, [&](const size_t off, const size_t len) {
+        romulusn::encrypt_update(&strm, txt.data() + off, enc1.data() + off,
+                                 len);
+      });
+      romulusn::finalize(&strm, tag1);
+
+      for (size_t i = 0; i < ctlen; i++) {
+        assert((enc0[i] ^ enc1[i]) == 0);
+      }
+      for (size_t i = 0; i < knt; i++) {
+        assert((tag0[i] ^ tag1[i]) == 0);
+      }
+
+      romulusn::init(&strm, &ctx, nonce);
+      feed_in_chunks(dlen, [&](const size_t off, const size_t len) {
+        romulusn::absorb_ad(&strm, data.data() + off, len);
+      });
+      feed_in_chunks(ctlen, [&](const size_t off, const size_t len) {
+        romulusn::decrypt_update(&strm, enc1.data() + off, dec.data() + off,
+                                 len);
+      });
+
+      tag1[knt - 1] ^= static_cast<uint8_t>(ctlen & 1);
+      const bool f = romulusn::verify(&strm, tag1);
+      assert(f == ((ctlen & 1) == 0));
+
+      for (size_t i = 0; i < ctlen; i++) {
+        assert((txt[i] ^ dec[i]) == 0);
+      }
+    }
+  }
+}
+
+// Tests that Romulus-N encryption/ decryption of a batch of messages, of varying
+// length, computes same cipher text and tag as one-shot routines do on each of
+// them, while verification failure of one message doesn't affect others
+static void romulusn_batch() {
+  constexpr size_t knt = 16;
+  constexpr size_t counts[] = {0, 1, 2, 63, 64, 65, 150};
+  constexpr size_t max_cnt = 150;
+  constexpr size_t max_len = 150;
+
+  uint8_t key[knt];
+  random_data(key, knt);
+
+  romulusn::context_t ctx;
+  romulusn::setup(&ctx, key);
+
+  for (const size_t cnt : counts) {
+    std::vector<uint8_t> nonces(cnt * knt);
+    std::vector<uint8_t> tags0(cnt * knt);
+    std::vector<uint8_t> tags1(cnt * knt);
+
+    std::vector<std::vector<uint8_t>> data(cnt);
+    std::vector<std::vector<uint8_t>> txt(cnt);
+    std::vector<std::vector<uint8_t>> enc0(cnt);
+    std::vector<std::vector<uint8_t>> enc1(cnt);
+    std::vector<std::vector<uint8_t>> dec(cnt);
+
+    std::vector<romulusn::message_t> msgs(cnt);
+
+    random_data(nonces.data(), nonces.size());
+
+    for (size_t i = 0; i < cnt; i++) {
+      uint8_t r[2];
+      random_data(r, sizeof(r));
+
+      const size_t dlen = r[0] % max_len;
+      const size_t ctlen = r[1] % max_len;
+
+      data[i].resize(dlen);
+      txt[i].resize(ctlen);
+      enc0[i].resize(ctlen);
+      enc1[i].resize(ctlen);
+      dec[i].resize(ctlen);
+
+      random_data(data[i].data(), dlen);
+      random_data(txt[i].data(), ctlen);
+
+      romulusn::encrypt(&ctx, nonces.data() + i * knt, data[i].data(), dlen,
+                        txt[i].data(), enc0[i].data(), ctlen,
+                        tags0.data() + i * knt);
+
+      msgs[i] = {nonces.data() + i * knt, data[i].data(), dlen, txt[i].data(),
+                 enc1[i].data(), ctlen, tags1.data() + i * knt};
+    }
+
+    romulusn::encrypt_batch(&ctx, msgs.data(), cnt);
+
+    for (size_t i = 0; i < cnt; i++) {
+      for (size_t j = 0; j < enc0[i].size(); j++) {
+        assert((enc0[i][j] ^ enc1[i][j]) == 0);
+      }
+    }
+    for (size_t i = 0; i < cnt * knt; i++) {
+      assert((tags0[i] ^ tags1[i]) == 0);
+    }
+
+    // tamper tag of every third message
+    for (size_t i = 0; i < cnt; i += 3) {
+      tags1[i * knt] ^= 1;
+    }
+
+    for (size_t i = 0; i < cnt; i++) {
+      msgs[i].src = enc1[i].data();
+      msgs[i].dst = dec[i].data();
+    }
+
+    bool flgs[max_cnt];
+    const bool f = romulusn::decrypt_batch(&ctx, msgs.data(), cnt, flgs);
+    assert(f == (cnt == 0));
+
+    for (size_t i = 0; i < cnt; i++) {
+      const bool tampered = (i % 3) == 0;
+      assert(flgs[i] == !tampered);
+
+      for (size_t j = 0; j < dec[i].size(); j++) {
+        assert(dec[i][j] == (tampered ? 0 : txt[i][j]));
+      }
+    }
+  }
+}
+
+// Tests that Romulus-M decryption, advancing MAC chain and decryption chain in
+// lockstep, recovers plain text, while rejecting ( and zeroing decrypted text )
+// when any byte of associated data, cipher text or tag is tampered with
+static void romulusm_interleaved() {
+  constexpr size_t knt = 16;
+  constexpr size_t max_dlen = 100;
+  constexpr size_t max_ctlen = 100;
+
+  uint8_t key[knt];
+  uint8_t nonce[knt];
+  uint8_t tag[knt];
+
+  std::vector<uint8_t> data(max_dlen);
+  std::vector<uint8_t> txt(max_ctlen);
+  std::vector<uint8_t> enc(max_ctlen);
+  std::vector<uint8_t> dec(max_ctlen);
+
+  for (size_t dlen = 0; dlen < max_dlen; dlen += 3) {
+    for (size_t ctlen = 0; ctlen < max_ctlen; ctlen += 3) {
+      random_data(key, knt);
+      random_data(nonce, knt);
+      random_data(data.data(), dlen);
+      random_data(txt.data(), ctlen);
+
+      romulusm::encrypt(key, nonce, data.data(), dlen, txt.data(), enc.data(),
+                        ctlen, tag);
+
+      bool f = false;
+      f = romulusm::decrypt(key, nonce, tag, data.data(), dlen, enc.data(),
+                            dec.data(), ctlen);
+      assert(f);
+
+      for (size_t i = 0; i < ctlen; i++) {
+        assert((txt[i] ^ dec[i]) == 0);
+      }
+
+      uint8_t* const ptrs[]{data.data(), enc.data(), tag};
+      const size_t lens[]{dlen, ctlen, knt};
+
+      for (size_t i = 0; i < 3; i++) {
+        if (lens[i] == 0) {
+          continue;
+        }
+
+        const size_t idx = (dlen ^ ctlen) % lens[i];
+
+        ptrs[i][idx] ^= 1;
+        f = romulusm::decrypt(key, nonce, tag, data.data(), dlen, enc.data(),
+                              dec.data(), ctlen);
+        ptrs[i][idx] ^= 1;
+
+        assert(!f);
+        for (size_t j = 0; j < ctlen; j++) {
+          assert(dec[j] == 0);
+        }
+      }
+    }
+  }
+}
+
+// Tests that Romulus-M decryption recovers plain text and rejects tampered
+// cipher text, when associated data and/ or plain text are longer than window,
+// by which decryption chain is allowed to run ahead of MAC chain
+static void romulusm_fused() {
+  constexpr size_t knt = 16;
+  constexpr size_t win = romulusm::FUSE_WINDOW;
+  constexpr size_t dlens[] = {0, 33, win + 17, 2 * win};
+  constexpr size_t ctlens[] = {win - 1, 2 * win + 33};
+
+  uint8_t key[knt];
+  uint8_t nonce[knt];
+  uint8_t tag[knt];
+
+  for (const size_t dlen : dlens) {
+    for (const size_t ctlen : ctlens) {
+      std::vector<uint8_t> data(dlen);
+      std::vector<uint8_t> txt(ctlen);
+      std::vector<uint8_t> enc(ctlen);
+      std::vector<uint8_t> dec(ctlen);
+
+      random_data(key, knt);
+      random_data(nonce, knt);
+      random_data(data.data(), dlen);
+      random_data(txt.data(), ctlen);
+
+      romulusm::encrypt(key, nonce, data.data(), dlen, txt.data(), enc.data(),
+                        ctlen, tag);
+
+      bool f = false;
+      f = romulusm::decrypt(key, nonce, tag, data.data(), dlen, enc.data(),
+                            dec.data(), ctlen);
+      assert(f);
+
+      for (size_t i = 0; i < ctlen; i++) {
+        assert((txt[i] ^ dec[i]) == 0);
+      }
+
+      enc[ctlen - 1] ^= 1;
+      f = romulusm::decrypt(key, nonce, tag, data.data(), dlen, enc.data(),
+                            dec.data(), ctlen);
+      assert(!f);
+
+      for (size_t i = 0; i < ctlen; i++) {
+        assert(dec[i] == 0);
+      }
+    }
+  }
+}
+
+// Tests that Romulus-{N, M, T} encryption/ decryption, starting from
+// associated data absorbed only once, computes same cipher text and tag as the
+// routines absorbing it for each message do, for many messages sharing it,
+// while also checking that tampered tag is rejected
+static void ad_snapshot() {
+  constexpr size_t knt = 16;
+  constexpr size_t max_dlen = 80;
+  constexpr size_t max_ctlen = 80;
+
+  uint8_t key[knt];
+  uint8_t nonce[knt];
+  uint8_t tag0[knt];
+  uint8_t tag1[knt];
+
+  random_data(key, knt);
+
+  romulusn::context_t ctx;
+  romulusn::setup(&ctx, key);
+
+  skinny::key_schedule_t ks;
+  skinny::expand_tk3(&ks, key);
+
+  std::vector<uint8_t> data(max_dlen);
+  std::vector<uint8_t> txt(max_ctlen);
+  std::vector<uint8_t> enc0(max_ctlen);
+  std::vector<uint8_t> enc1(max_ctlen);
+  std::vector<uint8_t> dec(max_ctlen);
+
+  for (size_t dlen = 0; dlen < max_dlen; dlen++) {
+    random_data(data.data(), dlen);
+
+    romulusn::ad_snapshot_t nsnap;
+    romulusm::ad_snapshot_t msnap;
+    romulust::ad_checkpoint_t tckpt;
+
+    romulusn::absorb(&nsnap, &ctx, data.data(), dlen);
+    romulusm::absorb(&msnap, &ks, data.data(), dlen);
+    romulust::absorb(&tckpt, data.data(), dlen);
+
+    for (size_t ctlen = 0; ctlen < max_ctlen; ctlen += 5) {
+      for (size_t scheme = 0; scheme < 3; scheme++) {
+        random_data(nonce, knt);
+        random_data(txt.data(), ctlen);
+
+        bool f = false;
+
+        if (scheme == 0) {
+          romulusn::encrypt(&ctx, nonce, data.data(), dlen, txt.data(),
+                            enc0.data(), ctlen, tag0);
+          romulusn::encrypt(&ctx, &nsnap, nonce, txt.data(), enc1.data(),
+                            ctlen, tag1);
+          f = romulusn::decrypt(&ctx, &nsnap, nonce, tag1, enc1.data(),
+                                dec.data(), ctlen);
+        } else if (scheme == 1) {
+          romulusm::encrypt(key, nonce, data.data(), dlen, txt.data(),
+                            enc0.data(), ctlen, tag0);
+          romulusm::encrypt(&ks, &msnap, nonce, txt.data(), enc1.data(), ctlen,
+                            tag1);
+          f = romulusm::decrypt(&ks, &msnap, nonce, tag1, enc1.data(),
+                                dec.data(), ctlen);
+        } else {
+          romulust::encrypt(key, nonce, data.data(), dlen, txt.data(),
+                            enc0.data(), ctlen, tag0);
+          romulust::encrypt(key, &tckpt, nonce, txt.data(), enc1.data(), ctlen,
+                            tag1);
+          f = romulust::decrypt(key, &tckpt, nonce, tag1, enc1.data(),
+                                dec.data(), ctlen);
+        }
+
+        assert(f);
+
+        for (size_t i = 0; i < ctlen; i++) {
+          assert((enc0[i] ^ enc1[i]) == 0);
+          assert((txt[i] ^ dec[i]) == 0);
+        }
+        for (size_t i = 0; i < knt; i++) {
+          assert((tag0[i] ^ tag1[i]) == 0);
+        }
+
+        tag1[0] ^= 1;
+
+        if (scheme == 0) {
+          f = romulusn::decrypt(&ctx, &nsnap, nonce, tag1, enc1.data(),
+                                dec.data(), ctlen);
+        } else if (scheme == 1) {
+          f = romulusm::decrypt(&ks, &msnap, nonce, tag1, enc1.data(),
+                                dec.data(), ctlen);
+        } else {
+          f = romulust::decrypt(key, &tckpt, nonce, tag1, enc1.data(),
+                                dec.data(), ctlen);
+        }
+
+        assert(!f);
+      }
+    }
+  }
+}
+
+// Tests that pipelined Romulus-T encryption, where keystream is generated on a
+// second thread, computes same cipher text and tag as serial routine does,
+// which decrypts back to plain text, while tampered tag is rejected, without
+// releasing any decrypted byte
+static void romulust_pipelined() {
+  constexpr size_t knt = 16;
+  constexpr size_t min_len = romulust::PIPELINE_MIN_LEN;
+  constexpr size_t ctlens[] = {0,           1,           min_len - 1, min_len,
+                               min_len + 1, min_len + 31, 5 * min_len + 17};
+  constexpr size_t dlens[] = {0, 1, 16, 17, 32, 100};
+
+  uint8_t key[knt];
+  uint8_t nonce[knt];
+  uint8_t tag0[knt];
+  uint8_t tag1[knt];
+
+  for (const size_t dlen : dlens) {
+    for (const size_t ctlen : ctlens) {
+      std::vector<uint8_t> data(dlen);
+      std::vector<uint8_t> txt(ctlen);
+      std::vector<uint8_t> enc0(ctlen);
+      std::vector<uint8_t> enc1(ctlen);
+      std::vector<uint8_t> dec(ctlen);
+
+      random_data(key, knt);
+      random_data(nonce, knt);
+      random_data(data.data(), dlen);
+      random_data(txt.data(), ctlen);
+
+      romulust::encrypt(key, nonce, data.data(), dlen, txt.data(), enc0.data(),
+                        ctlen, tag0);
+      romulust::encrypt_pipelined(key, nonce, data.data(), dlen, txt.data(),
+                                  enc1.data(), ctlen, tag1);
+
+      for (size_t i = 0; i < ctlen; i++) {
+        assert((enc0[i] ^ enc1[i]) == 0);
+      }
+      for (size_t i = 0; i < knt; i++) {
+        assert((tag0[i] ^ tag1[i]) == 0);
+      }
+
+      bool f = false;
+      f = romulust::decrypt(key, nonce, tag1, data.data(), dlen, enc1.data(),
+                            dec.data(), ctlen);
+      assert(f);
+
+      for (size_t i = 0; i < ctlen; i++) {
+        assert((txt[i] ^ dec[i]) == 0);
+      }
+
+      std::fill(dec.begin(), dec.end(), 0);
+
+      tag1[0] ^= 1;
+      f = romulust::decrypt(key, nonce, tag1, data.data(), dlen, enc1.data(),
+                            dec.data(), ctlen);
+      assert(!f);
+      assert(std::all_of(dec.begin(), dec.end(),
+                         [](const uint8_t b) { return b == 0; }));
+    }
+  }
+}
+
+// Tests that segmented container mode, on top of Romulus-{N, M, T}, recovers
+// any byte range of plain text from sealed message, while rejecting ranges
+// covering a tampered segment, but not others, as well as reordered or
+// truncated segments, where sealing/ opening on many threads produces same
+// output as doing so serially
+static void segmented_aead(const romulus_segmented::aead_t aead) {
+  constexpr size_t knt = 16;
+  constexpr size_t dlen = 21;
+  constexpr size_t seg_lens[] = {1, 16, 37, 64};
+  constexpr size_t ctlens[] = {0, 1, 36, 37, 38, 128, 200};
+
+  constexpr size_t nlen = romulus_segmented::NONCE_LEN;
+
+  uint8_t key[knt];
+  uint8_t nonce[nlen];
+  uint8_t data[dlen];
+
+  random_data(key, knt);
+  random_data(nonce, nlen);
+  random_data(data, dlen);
+
+  romulus_segmented::context_t k;
+  romulus_segmented::setup(&k, aead, key);
+
+  for (const size_t seg_len : seg_lens) {
+    for (const size_t ctlen : ctlens) {
+      const size_t slen = romulus_segmented::sealed_len(ctlen, seg_len);
+
+      std::vector<uint8_t> txt(ctlen);
+      std::vector<uint8_t> dec(ctlen);
+      std::vector<uint8_t> sealed(slen);
+
+      random_data(txt.data(), ctlen);
+
+      bool f = false;
+      f = romulus_segmented::seal(&k, nonce, data, dlen, txt.data(), ctlen,
+                                  seg_len, sealed.data());
+      assert(f);
+
+      size_t ptlen = 0;
+      assert(romulus_segmented::plain_len(slen, seg_len, &ptlen));
+      assert(ptlen == ctlen);
+
+      f = romulus_segmented::open(&k, nonce, data, dlen, sealed.data(), slen,
+                                  seg_len, dec.data());
+      assert(f);
+
+      for (size_t i = 0; i < ctlen; i++) {
+        assert((txt[i] ^ dec[i]) == 0);
+      }
+
+      // segments sealed/ opened concurrently
+      std::vector<uint8_t> psealed(slen);
+      std::vector<uint8_t> pdec(ctlen);
+
+      f = romulus_segmented::seal_parallel(&k, nonce, data, dlen, txt.data(),
+                                           ctlen, seg_len, psealed.data(), 3);
+      assert(f);
+
+      for (size_t i = 0; i < slen; i++) {
+        assert((sealed[i] ^ psealed[i]) == 0);
+      }
+
+      f = romulus_segmented::open_parallel(&k, nonce, data, dlen,
+                                           psealed.data(), slen, seg_len,
+                                           pdec.data(), 3);
+      assert(f);
+
+      for (size_t i = 0; i < ctlen; i++) {
+        assert((txt[i] ^ pdec[i]) == 0);
+      }
+
+      // random byte ranges
+      for (size_t i = 0; i < 16; i++) {
+        uint8_t r[2];
+        random_data(r, sizeof(r));
+
+        const size_t off = r[0] % (ctlen + 1);
+        const size_t len = r[1] % (ctlen - off + 1);
+
+        f = romulus_segmented::open_range(&k, nonce, data, dlen, sealed.data(),
+                                          slen, seg_len, off, dec.data(), len);
+        assert(f);
+
+        for (size_t j = 0; j < len; j++) {
+          assert((txt[off + j] ^ dec[j]) == 0);
+        }
+      }
+
+      if (ctlen <= seg_len) {
+        continue;
+      }
+
+      // tamper a byte of second segment
+      sealed[seg_len + knt] ^= 1;
+
+      f = romulus_segmented::open_range(&k, nonce, data, dlen, sealed.data(),
+                                        slen, seg_len, 0, dec.data(), seg_len);
+      assert(f);
+
+      f = romulus_segmented::open_range(&k, nonce, data, dlen, sealed.data(),
+                                        slen, seg_len, seg_len - 1, dec.data(),
+                                        2);
+      assert(!f);
+      assert((dec[0] | dec[1]) == 0);
+
+      f = romulus_segmented::open(&k, nonce, data, dlen, sealed.data(), slen,
+                                  seg_len, dec.data());
+      assert(!f);
+
+      f = romulus_segmented::open_parallel(&k, nonce, data, dlen,
+                                           sealed.data(), slen, seg_len,
+                                           pdec.data(), 3);
+      assert(!f);
+      assert(std::all_of(pdec.begin(), pdec.end(),
+                         [](const uint8_t b) { return b == 0; }));
+
+      sealed[seg_len + knt] ^= 1;
+
+      // swap first two segments, when both are of same length
+      if (ctlen >= 2 * seg_len) {
+        std::vector<uint8_t> swapped(sealed);
+
+        std::swap_ranges(swapped.begin(), swapped.begin() + seg_len + knt,
+                         swapped.begin() + seg_len + knt);
+
+        f = romulus_segmented::open(&k, nonce, data, dlen, swapped.data(),
+                                    slen, seg_len, dec.data());
+        assert(!f);
+      }
+
+      // drop last segment
+      const size_t cnt = romulus_segmented::segment_count(ctlen, seg_len);
+      const size_t tlen = (cnt - 1) * (seg_len + knt);
+
+      f = romulus_segmented::open(&k, nonce, data, dlen, sealed.data(), tlen,
+                                  seg_len, dec.data());
+      assert(!f);
+    }
+  }
+}
+
+// Tests that distinct ( message nonce, segment index, last segment flag )
+// triples never derive same segment nonce, including message nonces which only
+// differ in trailing bytes, such as those produced by a counter, and that
+// segments of two messages, sealed under such nonces, don't coincide
+static void segmented_nonce() {
+  constexpr size_t knt = 16;
+  constexpr size_t nlen = romulus_segmented::NONCE_LEN;
+  constexpr uint32_t idxs[] = {0u, 1u, 2u, 3u, 255u, 256u, 1u << 24,
+                               0xffffffffu};
+
+  // counter nonces 0..3 and nonces differing only in first byte
+  std::vector<std::array<uint8_t, nlen>> nonces(7);
+  for (size_t n = 0; n < 4; n++) {
+    nonces[n].fill(0);
+    nonces[n][nlen - 1] = static_cast<uint8_t>(n);
+  }
+  for (size_t n = 4; n < 7; n++) {
+    nonces[n].fill(0);
+    nonces[n][0] = static_cast<uint8_t>(n - 3);
+  }
+
+  std::vector<std::array<uint8_t, knt>> derived;
+
+  for (const auto& nonce : nonces) {
+    for (const uint32_t idx : idxs) {
+      for (size_t last = 0; last < 2; last++) {
+        std::array<uint8_t, knt> seg_nonce;
+        romulus_segmented::derive_nonce(nonce.data(), idx, last == 1,
+                                        seg_nonce.data());
+        derived.push_back(seg_nonce);
+      }
+    }
+  }
+
+  std::sort(derived.begin(), derived.end());
+  assert(std::adjacent_find(derived.begin(), derived.end()) == derived.end());
+
+  // messages sealed under counter nonces 0 and 1, with 3 equal segments each
+  constexpr size_t seg_len = 32;
+  constexpr size_t ctlen = 3 * seg_len;
+
+  const size_t slen = romulus_segmented::sealed_len(ctlen, seg_len);
+
+  uint8_t key[knt];
+  random_data(key, knt);
+
+  std::vector<uint8_t> txt(ctlen, 0);
+  std::vector<uint8_t> sealed0(slen);
+  std::vector<uint8_t> sealed1(slen);
+
+  romulus_segmented::context_t k;
+  romulus_segmented::setup(&k, romulus_segmented::aead_t::romulusn, key);
+
+  bool f = false;
+  f = romulus_segmented::seal(&k, nonces[0].data(), nullptr, 0, txt.data(),
+                              ctlen, seg_len, sealed0.data());
+  assert(f);
+
+  f = romulus_segmented::seal(&k, nonces[1].data(), nullptr, 0, txt.data(),
+                              ctlen, seg_len, sealed1.data());
+  assert(f);
+
+  for (size_t i = 0; i < 3; i++) {
+    for (size_t j = 0; j < 3; j++) {
+      const auto a = sealed0.begin() + i * (seg_len + knt);
+      const auto b = sealed1.begin() + j * (seg_len + knt);
+
+      assert(!std::equal(a, a + seg_len + knt, b));
+    }
+  }
+}
+
+// Tests that segmented container mode rejects zero segment length, while
+// sealing, opening or computing plain text length, instead of dividing by it,
+// zeroing requested plain text, as it'd do for any other malformed input
+static void segmented_zero_seg_len() {
+  constexpr size_t knt = 16;
+  constexpr size_t nlen = romulus_segmented::NONCE_LEN;
+  constexpr size_t ctlen = 48;
+  constexpr size_t slen = ctlen + knt;
+
+  uint8_t key[knt];
+  uint8_t nonce[nlen];
+
+  random_data(key, knt);
+  random_data(nonce, nlen);
+
+  std::vector<uint8_t> txt(ctlen);
+  std::vector<uint8_t> sealed(slen);
+  std::vector<uint8_t> dec(ctlen, 0xff);
+
+  random_data(txt.data(), ctlen);
+  random_data(sealed.data(), slen);
+
+  romulus_segmented::context_t k;
+  romulus_segmented::setup(&k, romulus_segmented::aead_t::romulusn, key);
+
+  size_t ptlen = 0;
+  assert(romulus_segmented::segment_count(ctlen, 0) == 0);
+  assert(!romulus_segmented::plain_len(slen, 0, &ptlen));
+
+  bool f = false;
+  f = romulus_segmented::seal(&k, nonce, nullptr, 0, txt.data(), ctlen, 0,
+                              sealed.data());
+  assert(!f);
+
+  f = romulus_segmented::seal_parallel(&k, nonce, nullptr, 0, txt.data(),
+                                       ctlen, 0, sealed.data(), 2);
+  assert(!f);
+
+  f = romulus_segmented::open(&k, nonce, nullptr, 0, sealed.data(), slen, 0,
+                              dec.data());
+  assert(!f);
+
+  f = romulus_segmented::open_parallel(&k, nonce, nullptr, 0, sealed.data(),
+                                       slen, 0, dec.data(), 2);
+  assert(!f);
+
+  f = romulus_segmented::open_range(&k, nonce, nullptr, 0, sealed.data(), slen,
+                                    0, 8, dec.data(), 16);
+  assert(!f);
+
+  for (size_t i = 0; i < 16; i++) {
+    assert(dec[i] == 0);
+  }
+}
+
+}  // namespace test_romulus
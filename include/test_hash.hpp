@@ -0,0 +1,196 @@
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+#include "romulush.hpp"
+#include "treehash.hpp"
+#include "utils.hpp"
+
+// Test functional correctness of Romulus AEAD/ Hash functions
+namespace test_romulus {
+
+// Tests that incremental Romulus-H hasher, fed with randomly sized chunks of
+// message, computes same digest as one-shot routine does
+static void romulush_hasher() {
+  constexpr size_t dlen = 32;
+  constexpr size_t max_mlen = 300;
+
+  std::vector<uint8_t> msg(max_mlen);
+
+  uint8_t dig0[dlen];
+  uint8_t dig1[dlen];
+
+  for (size_t mlen = 0; mlen < max_mlen; mlen++) {
+    random_data(msg.data(), mlen);
+
+    romulush::hash(msg.data(), mlen, dig0);
+
+    romulush::hasher_t hasher;
+    romulush::init(&hasher);
+
+    size_t off = 0;
+    while (off < mlen) {
+      uint8_t r;
+      random_data(&r, 1);
+
+      const size_t chunk = std::min<size_t>(r % 71, mlen - off);
+      romulush::absorb(&hasher, msg.data() + off, chunk);
+      off += chunk;
+    }
+
+    romulush::finalize(&hasher, dig1);
+
+    for (size_t i = 0; i < dlen; i++) {
+      assert((dig0[i] ^ dig1[i]) == 0);
+    }
+  }
+}
+
+// Tests that Romulus-H, applied on many independent messages of varying length,
+// computes same digests as one-shot routine does on each of them
+static void romulush_hash_many() {
+  constexpr size_t dlen = 32;
+  constexpr size_t counts[] = {0, 1, 2, 31, 32, 33, 100};
+  constexpr size_t max_mlen = 200;
+
+  for (const size_t cnt : counts) {
+    std::vector<std::vector<uint8_t>> msgs(cnt);
+    std::vector<uint8_t> digs0(cnt * dlen);
+    std::vector<uint8_t> digs1(cnt * dlen);
+
+    std::vector<const uint8_t*> msg_ptrs(cnt);
+    std::vector<size_t> mlens(cnt);
+    std::vector<uint8_t*> dig_ptrs(cnt);
+
+    for (size_t i = 0; i < cnt; i++) {
+      uint8_t r;
+      random_data(&r, 1);
+
+      mlens[i] = r % max_mlen;
+      msgs[i].resize(mlens[i]);
+      random_data(msgs[i].data(), mlens[i]);
+
+      msg_ptrs[i] = msgs[i].data();
+      dig_ptrs[i] = digs1.data() + i * dlen;
+
+      romulush::hash(msgs[i].data(), mlens[i], digs0.data() + i * dlen);
+    }
+
+    romulush::hash_many(msg_ptrs.data(), mlens.data(), dig_ptrs.data(), cnt);
+
+    for (size_t i = 0; i < cnt * dlen; i++) {
+      assert((digs0[i] ^ digs1[i]) == 0);
+    }
+  }
+}
+
+// Computes tree hash digest of N -bytes message, as it's defined, by hashing
+// header block prepended nodes, level by level, using one-shot Romulus-H
+static void treehash_reference(const uint8_t* const msg,
+                               const size_t mlen,
+                               uint8_t* const dig) {
+  using namespace romulus_treehash;
+
+  const size_t cnt = leaf_count(mlen);
+
+  std::vector<uint8_t> level(cnt * 32);
+  std::vector<uint8_t> buf(32 + std::max(LEAF_LEN, FANOUT * 32));
+
+  header(domain_t::leaf, buf.data());
+  for (size_t i = 0; i < cnt; i++) {
+    const size_t off = i * LEAF_LEN;
+    const size_t len = std::min(LEAF_LEN, mlen - off);
+
+    std::copy_n(msg + off, len, buf.begin() + 32);
+    romulush::hash(buf.data(), 32 + len, level.data() + i * 32);
+  }
+
+  size_t n = cnt;
+  header(domain_t::node, buf.data());
+  while (n > 1) {
+    const size_t m = (n + FANOUT - 1) / FANOUT;
+    std::vector<uint8_t> parents(m * 32);
+
+    for (size_t i = 0; i < m; i++) {
+      const size_t len = std::min(FANOUT, n - i * FANOUT) * 32;
+
+      std::copy_n(level.begin() + i * FANOUT * 32, len, buf.begin() + 32);
+      romulush::hash(buf.data(), 32 + len, parents.data() + i * 32);
+    }
+
+    level = std::move(parents);
+    n = m;
+  }
+
+  header(domain_t::root, buf.data());
+  std::copy_n(level.begin(), 32, buf.begin() + 32);
+  for (size_t i = 0; i < 8; i++) {
+    buf[64 + i] = static_cast<uint8_t>(static_cast<uint64_t>(mlen) >> (i * 8));
+  }
+  romulush::hash(buf.data(), 72, dig);
+}
+
+// Tests that tree hash, computed on many threads, as well as incrementally,
+// fed with randomly sized chunks of message, matches its definition, while
+// it's different from Romulus-H digest of same message
+static void romulus_treehash() {
+  using namespace romulus_treehash;
+
+  constexpr size_t dlen = 32;
+  constexpr size_t mlens[] = {0,
+                              1,
+                              32,
+                              LEAF_LEN - 1,
+                              LEAF_LEN,
+                              LEAF_LEN + 1,
+                              FANOUT * LEAF_LEN,
+                              FANOUT * LEAF_LEN + 33,
+                              FANOUT * FANOUT * LEAF_LEN,
+                              (FANOUT * FANOUT + 3) * LEAF_LEN + 5};
+  constexpr size_t threads[] = {1, 2, 3, 0};
+
+  for (const size_t mlen : mlens) {
+    std::vector<uint8_t> msg(mlen);
+    random_data(msg.data(), mlen);
+
+    uint8_t dig0[dlen];
+    uint8_t dig1[dlen];
+    uint8_t dig2[dlen];
+
+    treehash_reference(msg.data(), mlen, dig0);
+
+    for (const size_t t : threads) {
+      hash(msg.data(), mlen, dig1, t);
+
+      for (size_t i = 0; i < dlen; i++) {
+        assert((dig0[i] ^ dig1[i]) == 0);
+      }
+    }
+
+    hasher_t hasher;
+    init(&hasher);
+
+    size_t off = 0;
+    while (off < mlen) {
+      uint16_t r;
+      random_data(reinterpret_cast<uint8_t*>(&r), sizeof(r));
+
+      const size_t chunk = std::min<size_t>(r % 9000, mlen - off);
+      absorb(&hasher, msg.data() + off, chunk);
+      off += chunk;
+    }
+
+    finalize(&hasher, dig1);
+    romulush::hash(msg.data(), mlen, dig2);
+
+    bool diff = false;
+    for (size_t i = 0; i < dlen; i++) {
+      assert((dig0[i] ^ dig1[i]) == 0);
+      diff |= dig0[i] != dig2[i];
+    }
+    assert(diff);
+  }
+}
+
+}  // namespace test_romulus
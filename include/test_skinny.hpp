@@ -1,7 +1,12 @@
 #pragma once
 #include <cassert>
+#include <type_traits>
 
 #include "skinny.hpp"
+#include "skinny_bitsliced.hpp"
+#include "skinny_rows.hpp"
+#include "skinny_simd.hpp"
+#include "utils.hpp"
 
 // Test functional correctness of Romulus AEAD/ Hash functions
 namespace test_romulus {
@@ -27,6 +32,454 @@ static void skinny_tbc() {
   for (size_t i = 0; i < 16; i++) {
     assert((cipher[i] ^ st.arr[i]) == 0);
   }
+
+  skinny::initialize(&st, txt, tweakey);
+  skinny_rows::tbc(&st);
+
+  for (size_t i = 0; i < 16; i++) {
+    assert((cipher[i] ^ st.arr[i]) == 0);
+  }
+}
+
+// Tests that bitsliced Skinny-128-384+ TBC, processing LANES<T> -many blocks
+// together, computes same encrypted blocks as applying skinny::tbc on each of
+// them
+template<skinny_bitsliced::lane_word T>
+static void skinny_bitsliced_tbc() {
+  constexpr size_t cnt = skinny_bitsliced::LANES<T>;
+
+  skinny::state_t expected[cnt];
+  skinny::state_t computed[cnt];
+
+  for (size_t i = 0; i < cnt; i++) {
+    random_data(expected[i].arr, sizeof(expected[i].arr));
+    std::memcpy(computed[i].arr, expected[i].arr, sizeof(expected[i].arr));
+
+    skinny::tbc(expected + i);
+  }
+
+  skinny_bitsliced::tbc<T>(computed);
+
+  for (size_t i = 0; i < cnt; i++) {
+    for (size_t j = 0; j < 16; j++) {
+      assert((expected[i].arr[j] ^ computed[i].arr[j]) == 0);
+    }
+  }
+
+  // now all blocks share same tweakey state (3), expanded into round tweakeys
+  uint8_t key[16];
+  skinny::key_schedule_t ks;
+
+  random_data(key, sizeof(key));
+  skinny::expand_tk3(&ks, key);
+
+  for (size_t i = 0; i < cnt; i++) {
+    random_data(expected[i].arr, 48);
+    std::memcpy(expected[i].arr + 48, key, sizeof(key));
+    std::memcpy(computed[i].arr, expected[i].arr, 48);
+
+    skinny::tbc(expected + i);
+  }
+
+  skinny_bitsliced::tbc<T>(computed, &ks);
+
+  for (size_t i = 0; i < cnt; i++) {
+    for (size_t j = 0; j < 16; j++) {
+      assert((expected[i].arr[j] ^ computed[i].arr[j]) == 0);
+    }
+  }
+}
+
+// Tests that Skinny-128-384+ TBC, applied on arbitrary many blocks, computes
+// same encrypted blocks as applying skinny::tbc on each of them
+static void skinny_tbc_many() {
+  constexpr size_t counts[] = {0, 1, 7, 8, 9, 16, 31, 32, 64, 65, 100, 133};
+  constexpr size_t max_cnt = 133;
+
+  skinny::state_t expected[max_cnt];
+  skinny::state_t computed[max_cnt];
+
+  for (const size_t cnt : counts) {
+    for (size_t i = 0; i < cnt; i++) {
+      random_data(expected[i].arr, sizeof(expected[i].arr));
+      std::memcpy(computed[i].arr, expected[i].arr, sizeof(expected[i].arr));
+
+      skinny::tbc(expected + i);
+    }
+
+    skinny_bitsliced::tbc_many(computed, cnt);
+
+    for (size_t i = 0; i < cnt; i++) {
+      for (size_t j = 0; j < 16; j++) {
+        assert((expected[i].arr[j] ^ computed[i].arr[j]) == 0);
+      }
+    }
+  }
+}
+
+// Tests that Skinny-128-384+ TBC, applied on arbitrary many blocks, sharing same
+// tweakey state (3), which is expanded into round tweakeys, computes same
+// encrypted blocks as applying skinny::tbc on each of them
+static void skinny_tbc_many_key_schedule() {
+  constexpr size_t counts[] = {0, 1, 7, 8, 9, 16, 31, 32, 64, 65, 100, 133};
+  constexpr size_t max_cnt = 133;
+
+  skinny::state_t expected[max_cnt];
+  skinny::state_t computed[max_cnt];
+
+  uint8_t key[16];
+  skinny::key_schedule_t ks;
+
+  random_data(key, sizeof(key));
+  skinny::expand_tk3(&ks, key);
+
+  for (const size_t cnt : counts) {
+    for (size_t i = 0; i < cnt; i++) {
+      random_data(expected[i].arr, 48);
+      std::memcpy(expected[i].arr + 48, key, sizeof(key));
+      std::memcpy(computed[i].arr, expected[i].arr, 48);
+
+      skinny::tbc(expected + i);
+    }
+
+    skinny_bitsliced::tbc_many(computed, cnt, &ks);
+
+    for (size_t i = 0; i < cnt; i++) {
+      for (size_t j = 0; j < 16; j++) {
+        assert((expected[i].arr[j] ^ computed[i].arr[j]) == 0);
+      }
+    }
+  }
+}
+
+#if defined(SKINNY_SIMD_X86)
+
+// Runs given test on AVX2 and AVX-512 implementations of some Skinny-128-384+
+// TBC variant, for those of them which can be executed on this CPU, see
+// skinny_simd::supports
+template<typename T>
+static void test_simd_impls(void (*test)(T),
+                            const std::type_identity_t<T> impl_avx2,
+                            const std::type_identity_t<T> impl_avx512) {
+  if (skinny_simd::supports(skinny_simd::isa_t::avx2)) {
+    test(impl_avx2);
+  }
+  if (skinny_simd::supports(skinny_simd::isa_t::avx512)) {
+    test(impl_avx512);
+  }
+}
+
+#endif
+
+// Tests that given Skinny-128-384+ TBC implementation computes same state as
+// skinny::tbc does, on random input states
+static void skinny_tbc_impl(const skinny_simd::tbc_t impl) {
+  constexpr size_t cnt = 64;
+
+  for (size_t i = 0; i < cnt; i++) {
+    skinny::state_t expected;
+    skinny::state_t computed;
+
+    random_data(expected.arr, sizeof(expected.arr));
+    std::memcpy(computed.arr, expected.arr, sizeof(expected.arr));
+
+    skinny::tbc(&expected);
+    impl(&computed);
+
+    for (size_t j = 0; j < sizeof(expected.arr); j++) {
+      assert((expected.arr[j] ^ computed.arr[j]) == 0);
+    }
+  }
+}
+
+// Tests row-word Skinny-128-384+ TBC implementation and vectorized ones, which
+// are supported by CPU, along with the one picked by run time dispatcher
+static void skinny_simd_tbc() {
+#if defined(SKINNY_SIMD_X86)
+  test_simd_impls(skinny_tbc_impl, skinny_simd::tbc_avx2,
+                  skinny_simd::tbc_avx512);
+#endif
+
+  skinny_tbc_impl(skinny_rows::tbc);
+  skinny_tbc_impl(skinny_simd::tbc);
+}
+
+// Tests that given Skinny-128-384+ TBC implementation, consuming precomputed
+// round tweakeys of tweakey state (3), computes same internal state and tweakey
+// state (1, 2) as skinny::tbc does, on random input states
+static void skinny_tbc_ks_impl(const skinny_simd::tbc_ks_t impl) {
+  constexpr size_t cnt = 64;
+
+  for (size_t i = 0; i < cnt; i++) {
+    skinny::state_t expected;
+    skinny::state_t computed;
+    skinny::key_schedule_t ks;
+
+    random_data(expected.arr, sizeof(expected.arr));
+    std::memcpy(computed.arr, expected.arr, 48);
+    skinny::expand_tk3(&ks, expected.arr + 48);
+
+    skinny::tbc(&expected);
+    impl(&computed, &ks);
+
+    for (size_t j = 0; j < 48; j++) {
+      assert((expected.arr[j] ^ computed.arr[j]) == 0);
+    }
+  }
+}
+
+// Tests Skinny-128-384+ TBC implementations, which consume precomputed round
+// tweakeys, for portable one, vectorized ones supported by CPU and the one
+// picked by run time dispatcher
+static void skinny_tbc_key_schedule() {
+  skinny_tbc_ks_impl(skinny::tbc);
+  skinny_tbc_ks_impl(skinny_rows::tbc);
+
+#if defined(SKINNY_SIMD_X86)
+  test_simd_impls(skinny_tbc_ks_impl, skinny_simd::tbc_avx2,
+                  skinny_simd::tbc_avx512);
+#endif
+
+  skinny_tbc_ks_impl(skinny_simd::tbc);
+}
+
+// Tests that given Skinny-128-384+ TBC implementation, consuming precomputed
+// round tweakeys of tweakey state (2, 3), computes same internal state and
+// tweakey state (1) as skinny::tbc does, on random input states, while both
+// ways of expanding those round tweakeys agree
+static void skinny_tbc_ts_impl(const skinny_simd::tbc_ts_t impl) {
+  constexpr size_t cnt = 64;
+
+  for (size_t i = 0; i < cnt; i++) {
+    skinny::state_t expected;
+    skinny::state_t computed;
+    skinny::key_schedule_t ks;
+    skinny::tweakey_schedule_t ts;
+    skinny::tweakey_schedule_t ts_;
+
+    random_data(expected.arr, sizeof(expected.arr));
+    std::memcpy(computed.arr, expected.arr, 32);
+    skinny::expand_tk3(&ks, expected.arr + 48);
+    skinny::expand_tk2(&ts, expected.arr + 32, &ks);
+    skinny_rows::expand_tk2(&ts_, expected.arr + 32, &ks);
+
+    assert(std::memcmp(&ts, &ts_, sizeof(ts)) == 0);
+
+    skinny::tbc(&expected);
+    impl(&computed, &ts);
+
+    for (size_t j = 0; j < 32; j++) {
+      assert((expected.arr[j] ^ computed.arr[j]) == 0);
+    }
+  }
+}
+
+// Tests Skinny-128-384+ TBC implementations, which consume precomputed round
+// tweakeys of tweakey state (2, 3), for portable one, vectorized ones supported
+// by CPU and the one picked by run time dispatcher
+static void skinny_tbc_tweakey_schedule() {
+  skinny_tbc_ts_impl(skinny::tbc);
+  skinny_tbc_ts_impl(skinny_rows::tbc);
+
+#if defined(SKINNY_SIMD_X86)
+  test_simd_impls(skinny_tbc_ts_impl, skinny_simd::tbc_avx2,
+                  skinny_simd::tbc_avx512);
+#endif
+
+  skinny_tbc_ts_impl(skinny_simd::tbc);
+}
+
+// Tests that given Skinny-128-384+ TBC implementation, encrypting two
+// independent states while sharing round tweakeys of tweakey state (3),
+// computes same internal states and tweakey states (1, 2) as skinny::tbc does
+// on each of them, on random input states
+static void skinny_tbc_pair_impl(const skinny_simd::tbc_pair_t impl) {
+  constexpr size_t cnt = 64;
+
+  for (size_t i = 0; i < cnt; i++) {
+    skinny::state_t expected0;
+    skinny::state_t expected1;
+    skinny::state_t computed0;
+    skinny::state_t computed1;
+    skinny::key_schedule_t ks;
+
+    random_data(expected0.arr, sizeof(expected0.arr));
+    random_data(expected1.arr, 48);
+
+    std::memcpy(expected1.arr + 48, expected0.arr + 48, 16);
+    std::memcpy(computed0.arr, expected0.arr, 48);
+    std::memcpy(computed1.arr, expected1.arr, 48);
+    skinny::expand_tk3(&ks, expected0.arr + 48);
+
+    skinny::tbc(&expected0);
+    skinny::tbc(&expected1);
+    impl(&computed0, &computed1, &ks);
+
+    for (size_t j = 0; j < 48; j++) {
+      assert((expected0.arr[j] ^ computed0.arr[j]) == 0);
+      assert((expected1.arr[j] ^ computed1.arr[j]) == 0);
+    }
+  }
+}
+
+// Tests Skinny-128-384+ TBC implementations, which encrypt two independent
+// states sharing round tweakeys of tweakey state (3), for portable one,
+// vectorized ones supported by CPU and the one picked by run time dispatcher
+static void skinny_tbc_pair() {
+  skinny_tbc_pair_impl(skinny::tbc_pair);
+  skinny_tbc_pair_impl(skinny_rows::tbc_pair);
+
+#if defined(SKINNY_SIMD_X86)
+  test_simd_impls(skinny_tbc_pair_impl, skinny_simd::tbc_pair_avx2,
+                  skinny_simd::tbc_pair_avx512);
+#endif
+
+  skinny_tbc_pair_impl(skinny_simd::tbc_pair);
+}
+
+// Tests that given Skinny-128-384+ TBC implementation, encrypting two blocks
+// under same tweakey, computes same encrypted blocks as calling skinny::tbc on
+// each of them does, on random input states
+static void skinny_tbc2_impl(const skinny_simd::tbc2_t impl) {
+  constexpr size_t cnt = 64;
+
+  for (size_t i = 0; i < cnt; i++) {
+    skinny::state_t expected0;
+    skinny::state_t expected1;
+    skinny::state_t computed;
+    uint8_t blk[16];
+
+    random_data(expected0.arr, sizeof(expected0.arr));
+    random_data(blk, sizeof(blk));
+
+    std::memcpy(expected1.arr, blk, 16);
+    std::memcpy(expected1.arr + 16, expected0.arr + 16, 48);
+    std::memcpy(computed.arr, expected0.arr, sizeof(expected0.arr));
+
+    skinny::tbc(&expected0);
+    skinny::tbc(&expected1);
+    impl(&computed, blk);
+
+    for (size_t j = 0; j < sizeof(expected0.arr); j++) {
+      assert((expected0.arr[j] ^ computed.arr[j]) == 0);
+    }
+    for (size_t j = 0; j < 16; j++) {
+      assert((expected1.arr[j] ^ blk[j]) == 0);
+    }
+  }
+}
+
+// Tests Skinny-128-384+ TBC implementations, which encrypt two blocks under same
+// tweakey, for portable one, vectorized ones supported by CPU and the one
+// picked by run time dispatcher
+static void skinny_tbc2() {
+  skinny_tbc2_impl(skinny::tbc2);
+  skinny_tbc2_impl(skinny_rows::tbc2);
+
+#if defined(SKINNY_SIMD_X86)
+  test_simd_impls(skinny_tbc2_impl, skinny_simd::tbc2_avx2,
+                  skinny_simd::tbc2_avx512);
+#endif
+
+  skinny_tbc2_impl(skinny_simd::tbc2);
+}
+
+// Tests that given Skinny-128-384+ TBC implementation, doing what two
+// independent `tbc2` calls do, computes same encrypted blocks as calling
+// skinny::tbc on each of four blocks does, on random input states
+static void skinny_tbc2x2_impl(const skinny_simd::tbc2x2_t impl) {
+  constexpr size_t cnt = 64;
+
+  for (size_t i = 0; i < cnt; i++) {
+    skinny::state_t expected[4];
+    skinny::state_t computed[2];
+    uint8_t blk[2][16];
+
+    for (size_t k = 0; k < 2; k++) {
+      random_data(expected[k << 1].arr, sizeof(expected[k << 1].arr));
+      random_data(blk[k], sizeof(blk[k]));
+
+      std::memcpy(expected[(k << 1) + 1].arr, blk[k], 16);
+      std::memcpy(expected[(k << 1) + 1].arr + 16, expected[k << 1].arr + 16,
+                  48);
+      std::memcpy(computed[k].arr, expected[k << 1].arr,
+                  sizeof(expected[k << 1].arr));
+    }
+
+    for (size_t k = 0; k < 4; k++) {
+      skinny::tbc(expected + k);
+    }
+    impl(computed + 0, blk[0], computed + 1, blk[1]);
+
+    for (size_t k = 0; k < 2; k++) {
+      for (size_t j = 0; j < sizeof(computed[k].arr); j++) {
+        assert((expected[k << 1].arr[j] ^ computed[k].arr[j]) == 0);
+      }
+      for (size_t j = 0; j < 16; j++) {
+        assert((expected[(k << 1) + 1].arr[j] ^ blk[k][j]) == 0);
+      }
+    }
+  }
+}
+
+// Tests Skinny-128-384+ TBC implementations, which do what two independent
+// `tbc2` calls do, for vectorized ones supported by CPU and the one picked by
+// run time dispatcher
+static void skinny_tbc2x2() {
+#if defined(SKINNY_SIMD_X86)
+  test_simd_impls(skinny_tbc2x2_impl, skinny_simd::tbc2x2_avx2,
+                  skinny_simd::tbc2x2_avx512);
+#endif
+
+  skinny_tbc2x2_impl(skinny_simd::tbc2x2);
+}
+
+// Tests that given Skinny-128-384+ TBC implementation, encrypting same block
+// under two tweakeys differing only in tweakey state (1), computes same
+// encrypted blocks as calling skinny::tbc under each of those tweakeys does
+static void skinny_tbc2_tk1_impl(const skinny_simd::tbc2_tk1_t impl) {
+  constexpr size_t cnt = 64;
+
+  for (size_t i = 0; i < cnt; i++) {
+    skinny::state_t expected0;
+    skinny::state_t expected1;
+    skinny::state_t computed;
+    uint8_t tk1[16];
+    uint8_t blk[16];
+
+    random_data(expected0.arr, sizeof(expected0.arr));
+    random_data(tk1, sizeof(tk1));
+
+    std::memcpy(expected1.arr, expected0.arr, sizeof(expected0.arr));
+    std::memcpy(expected1.arr + 16, tk1, sizeof(tk1));
+    std::memcpy(computed.arr, expected0.arr, sizeof(expected0.arr));
+
+    skinny::tbc(&expected0);
+    skinny::tbc(&expected1);
+    impl(&computed, tk1, blk);
+
+    for (size_t j = 0; j < sizeof(expected0.arr); j++) {
+      assert((expected0.arr[j] ^ computed.arr[j]) == 0);
+    }
+    for (size_t j = 0; j < 16; j++) {
+      assert((expected1.arr[j] ^ blk[j]) == 0);
+    }
+  }
+}
+
+// Tests Skinny-128-384+ TBC implementations, which encrypt same block under two
+// tweakeys differing only in tweakey state (1), for portable one, vectorized
+// ones supported by CPU and the one picked by run time dispatcher
+static void skinny_tbc2_tk1() {
+  skinny_tbc2_tk1_impl(skinny::tbc2_tk1);
+  skinny_tbc2_tk1_impl(skinny_rows::tbc2_tk1);
+
+#if defined(SKINNY_SIMD_X86)
+  test_simd_impls(skinny_tbc2_tk1_impl, skinny_simd::tbc2_tk1_avx2,
+                  skinny_simd::tbc2_tk1_avx512);
+#endif
+
+  skinny_tbc2_tk1_impl(skinny_simd::tbc2_tk1);
 }
 
 }  // namespace test_romulus
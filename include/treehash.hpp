@@ -0,0 +1,345 @@
+#pragma once
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "romulush.hpp"
+
+// Tree hashing mode on top of Romulus-H, where message is split into fixed
+// size leaves, each of them hashed independently, while digests of every
+// `FANOUT` -many consecutive nodes are hashed into their parent node, level by
+// level, until only one node is left. Finally that node's digest is hashed,
+// along with message length, into 32 -bytes root digest.
+//
+// Leaves, inner nodes and root are domain separated by prepending a distinct
+// 32 -bytes header block to what's hashed at each of them, which also encodes
+// tree parameters. As Romulus-H compresses full message blocks before padded
+// last one, hashing starts from chaining state reached after compressing that
+// header block, so every node is a plain Romulus-H digest, i.e.
+//
+// leaf digest  = Romulus-H(header(leaf) || leaf)
+// node digest  = Romulus-H(header(node) || child_0 || ... || child_(k-1))
+// root digest  = Romulus-H(header(root) || top || len(msg) as 64 -bit LE)
+//
+// where 1 <= k <= FANOUT and empty message has one empty leaf. When message
+// has a single leaf, its digest is the top node.
+//
+// See Romulus-H in section 2.4.6 of Romulus specification
+// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/romulus-spec-final.pdf
+namespace romulus_treehash {
+
+// Length of each leaf, in bytes, which is a multiple of Romulus-H block size,
+// except last leaf, which carries remaining bytes
+constexpr size_t LEAF_LOG = 13;
+constexpr size_t LEAF_LEN = 1ul << LEAF_LOG;
+
+// Maximum number of children of each inner node
+constexpr size_t FANOUT_LOG = 3;
+constexpr size_t FANOUT = 1ul << FANOUT_LOG;
+
+// Maximum number of tree levels, including leaves, for messages shorter than
+// 2^64 bytes
+constexpr size_t MAX_LEVELS =
+    (64 - LEAF_LOG + FANOUT_LOG - 1) / FANOUT_LOG + 1;
+
+static_assert(LEAF_LEN % 32 == 0, "Leaf must consist of full blocks !");
+
+// Domain of tree node, hashed in first byte of its header block
+enum class domain_t : uint8_t { leaf = 1, node = 2, root = 3 };
+
+// Prepares 32 -bytes header block of given domain, binding tree parameters
+inline static void header(const domain_t dom, uint8_t* const __restrict blk) {
+  std::memset(blk, 0, 32);
+
+  blk[0] = static_cast<uint8_t>(dom);
+  blk[1] = static_cast<uint8_t>(FANOUT);
+  blk[2] = static_cast<uint8_t>(LEAF_LOG);
+}
+
+// Computes 32 -bytes Romulus-H chaining state ( i.e. left || right ), reached
+// after compressing header block of given domain, from which hashing of each
+// node of that domain continues
+inline static void derive_iv(const domain_t dom, uint8_t* const __restrict iv) {
+  uint8_t blk[32];
+  header(dom, blk);
+
+  std::memset(iv, 0, 32);
+  romulush::compress(iv, iv + 16, blk);
+}
+
+// Number of leaves, N -bytes message is split into | N >= 0
+inline static constexpr size_t leaf_count(const size_t mlen) {
+  return std::max<size_t>(1, (mlen + LEAF_LEN - 1) >> LEAF_LOG);
+}
+
+// Hashes leaves [first, first + cnt) of N -bytes message, writing their 32
+// -bytes digests at matching offsets of `digs`, where up to `MANY_LANES` leaves
+// are hashed together, using multi-block Skinny-128-384+
+inline static void hash_leaves(
+    const uint8_t* const __restrict msg,  // N -bytes input message
+    const size_t mlen,                    // len(msg) = N | >= 0
+    const size_t first,                   // index of first leaf to be hashed
+    const size_t cnt,                     // number of leaves to be hashed
+    const uint8_t* const __restrict iv,   // 32 -bytes leaf chaining state
+    uint8_t* const __restrict digs        // 32 -bytes digest of each leaf
+) {
+  constexpr size_t lanes = romulush::MANY_LANES;
+
+  const uint8_t* msgs[lanes];
+  size_t mlens[lanes];
+  uint8_t* outs[lanes];
+
+  for (size_t i = first; i < first + cnt; i += lanes) {
+    const size_t n = std::min(lanes, first + cnt - i);
+
+    for (size_t j = 0; j < n; j++) {
+      const size_t off = (i + j) << LEAF_LOG;
+
+      msgs[j] = msg + off;
+      mlens[j] = std::min(LEAF_LEN, mlen - off);
+      outs[j] = digs + ((i + j) << 5);
+    }
+
+    romulush::hash_many(msgs, mlens, outs, n, iv);
+  }
+}
+
+// Hashes digests of M -many nodes of a level into their ceil(M / FANOUT) -many
+// parent nodes | M > 1, using multi-block Skinny-128-384+
+inline static void hash_level(
+    const uint8_t* const __restrict digs,  // 32 -bytes digest of each node
+    const size_t cnt,                      // number of nodes = M
+    const uint8_t* const __restrict iv,    // 32 -bytes node chaining state
+    uint8_t* const __restrict parents      // 32 -bytes digest of each parent
+) {
+  constexpr size_t lanes = romulush::MANY_LANES;
+  constexpr size_t span = FANOUT << 5;
+
+  const size_t pcnt = (cnt + FANOUT - 1) / FANOUT;
+
+  const uint8_t* msgs[lanes];
+  size_t mlens[lanes];
+  uint8_t* outs[lanes];
+
+  for (size_t i = 0; i < pcnt; i += lanes) {
+    const size_t n = std::min(lanes, pcnt - i);
+
+    for (size_t j = 0; j < n; j++) {
+      const size_t off = (i + j) * span;
+
+      msgs[j] = digs + off;
+      mlens[j] = std::min(span, (cnt << 5) - off);
+      outs[j] = parents + ((i + j) << 5);
+    }
+
+    romulush::hash_many(msgs, mlens, outs, n, iv);
+  }
+}
+
+// Hashes 32 -bytes top node digest, along with message length, into 32 -bytes
+// root digest
+inline static void hash_root(const uint8_t* const __restrict top,
+                             const uint64_t mlen,
+                             uint8_t* const __restrict dig) {
+  uint8_t iv[32];
+  uint8_t msg[40];
+
+  derive_iv(domain_t::root, iv);
+
+  std::memcpy(msg, top, 32);
+  for (size_t i = 0; i < 8; i++) {
+    msg[32 + i] = static_cast<uint8_t>(mlen >> (i << 3));
+  }
+
+  romulush::hasher_t hasher;
+  romulush::init(&hasher, iv);
+  romulush::absorb(&hasher, msg, sizeof(msg));
+  romulush::finalize(&hasher, dig);
+}
+
+// Given N -bytes input message | N >= 0, this routine computes its 32 -bytes
+// tree hash digest, where leaves are hashed concurrently, on `threads` -many
+// threads | threads = 0 means as many as there are hardware threads. Each
+// thread hashes a contiguous run of leaves, `MANY_LANES` -many at a time, using
+// multi-block Skinny-128-384+, after which inner levels are hashed on calling
+// thread, as they're FANOUT times shorter, each.
+inline static void hash(
+    const uint8_t* const __restrict msg,  // input message to be hashed
+    const size_t mlen,                    // len(msg) >= 0
+    uint8_t* const __restrict dig,        // 32 -bytes digest computed
+    size_t threads                        // number of threads to be used
+) {
+  constexpr size_t lanes = romulush::MANY_LANES;
+
+  const size_t cnt = leaf_count(mlen);
+  const size_t batches = (cnt + lanes - 1) / lanes;
+
+  if (threads == 0) {
+    threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+  }
+  threads = std::max<size_t>(1, std::min(threads, batches));
+
+  std::vector<uint8_t> level(cnt << 5);
+  std::vector<uint8_t> parents(((cnt + FANOUT - 1) / FANOUT) << 5);
+
+  uint8_t iv[32];
+  derive_iv(domain_t::leaf, iv);
+
+  // leaves cost the same, so batches of them are evenly split among threads
+  auto worker = [&](const size_t t) {
+    const size_t from = std::min(cnt, (batches * t / threads) * lanes);
+    const size_t to = std::min(cnt, (batches * (t + 1) / threads) * lanes);
+
+    hash_leaves(msg, mlen, from, to - from, iv, level.data());
+  };
+
+  std::vector<std::thread> pool;
+  pool.reserve(threads - 1);
+
+  for (size_t t = 1; t < threads; t++) {
+    pool.emplace_back(worker, t);
+  }
+
+  worker(0);
+
+  for (auto& t : pool) {
+    t.join();
+  }
+
+  derive_iv(domain_t::node, iv);
+
+  size_t n = cnt;
+  while (n > 1) {
+    hash_level(level.data(), n, iv, parents.data());
+
+    n = (n + FANOUT - 1) / FANOUT;
+    std::swap(level, parents);
+  }
+
+  hash_root(level.data(), mlen, dig);
+}
+
+// Incremental tree hasher state, which allows message to be absorbed in
+// arbitrary sized chunks, computing same digest as one-shot `hash` routine.
+// Each leaf is hashed as soon as it's full, while as soon as a level collects
+// FANOUT -many digests, they're hashed into parent node, so only rightmost
+// path of the tree is kept in memory.
+//
+// Expected call sequence is `init` -> `absorb`* -> `finalize`.
+struct hasher_t {
+  romulush::hasher_t leaf;                // Romulus-H hasher of current leaf
+  size_t leaf_fill;                       // bytes absorbed into current leaf
+  uint64_t mlen;                          // bytes absorbed so far
+  uint8_t leaf_iv[32];                    // leaf chaining state
+  uint8_t node_iv[32];                    // inner node chaining state
+  uint8_t pend[MAX_LEVELS][FANOUT << 5];  // pending digests of each level
+  size_t pcnt[MAX_LEVELS];                // number of pending digests
+  uint64_t total[MAX_LEVELS];             // number of digests ever on level
+};
+
+// Prepares incremental tree hasher state for hashing a new message
+inline static void init(hasher_t* const __restrict hasher) {
+  derive_iv(domain_t::leaf, hasher->leaf_iv);
+  derive_iv(domain_t::node, hasher->node_iv);
+
+  romulush::init(&hasher->leaf, hasher->leaf_iv);
+  hasher->leaf_fill = 0;
+  hasher->mlen = 0;
+
+  std::memset(hasher->pcnt, 0, sizeof(hasher->pcnt));
+  std::memset(hasher->total, 0, sizeof(hasher->total));
+}
+
+// Appends 32 -bytes node digest to given level, hashing that level's pending
+// digests into their parent, on next level, as soon as FANOUT of them are
+// collected
+inline static void push(hasher_t* const __restrict hasher,
+                        size_t lvl,
+                        const uint8_t* const __restrict dig) {
+  uint8_t node[32];
+  std::memcpy(node, dig, 32);
+
+  while (true) {
+    std::memcpy(hasher->pend[lvl] + (hasher->pcnt[lvl] << 5), node, 32);
+    hasher->pcnt[lvl]++;
+    hasher->total[lvl]++;
+
+    if (hasher->pcnt[lvl] < FANOUT) {
+      return;
+    }
+
+    romulush::hasher_t h;
+    romulush::init(&h, hasher->node_iv);
+    romulush::absorb(&h, hasher->pend[lvl], FANOUT << 5);
+    romulush::finalize(&h, node);
+
+    hasher->pcnt[lvl] = 0;
+    lvl++;
+  }
+}
+
+// Absorbs N -bytes message into incremental tree hasher state | N >= 0, which
+// can be called any number of times, before finalizing it.
+inline static void absorb(
+    hasher_t* const __restrict hasher,    // tree hasher
+    const uint8_t* const __restrict msg,  // message to be absorbed
+    const size_t mlen                     // len(msg) >= 0
+) {
+  size_t off = 0;
+
+  while (off < mlen) {
+    const size_t take = std::min(LEAF_LEN - hasher->leaf_fill, mlen - off);
+
+    romulush::absorb(&hasher->leaf, msg + off, take);
+    hasher->leaf_fill += take;
+    off += take;
+
+    if (hasher->leaf_fill == LEAF_LEN) {
+      uint8_t dig[32];
+      romulush::finalize(&hasher->leaf, dig);
+      push(hasher, 0, dig);
+
+      romulush::init(&hasher->leaf, hasher->leaf_iv);
+      hasher->leaf_fill = 0;
+    }
+  }
+
+  hasher->mlen += mlen;
+}
+
+// Finalizes incremental tree hasher state, computing 32 -bytes root digest,
+// after which hasher state must be re-initialized, before it can be used again
+inline static void finalize(
+    hasher_t* const __restrict hasher,  // tree hasher
+    uint8_t* const __restrict dig       // 32 -bytes digest computed
+) {
+  uint8_t node[32];
+
+  // last leaf is partially filled, unless message length is a non-zero
+  // multiple of leaf length, in which case it's already pushed
+  if ((hasher->leaf_fill > 0) | (hasher->mlen == 0)) {
+    romulush::finalize(&hasher->leaf, node);
+    push(hasher, 0, node);
+  }
+
+  // hash pending digests of each level into their parent, going up, until a
+  // level is reached, which had only one digest, which is top node
+  size_t lvl = 0;
+  while (hasher->total[lvl] > 1) {
+    if (hasher->pcnt[lvl] > 0) {
+      romulush::hasher_t h;
+      romulush::init(&h, hasher->node_iv);
+      romulush::absorb(&h, hasher->pend[lvl], hasher->pcnt[lvl] << 5);
+      romulush::finalize(&h, node);
+
+      hasher->pcnt[lvl] = 0;
+      push(hasher, lvl + 1, node);
+    }
+
+    lvl++;
+  }
+
+  hash_root(hasher->pend[lvl], hasher->mlen, dig);
+}
+
+}  // namespace romulus_treehash
@@ -0,0 +1,96 @@
+#include <iostream>
+
+#include "test_aead.hpp"
+#include "test_hash.hpp"
+#include "test_skinny.hpp"
+
+// Executes functional correctness tests of Romulus AEAD/ Hash routines and
+// underlying Skinny-128-384+ TBC, on CPU
+int main() {
+  test_romulus::skinny_tbc();
+  std::cout << "[test] Skinny-128-384+ TBC" << std::endl;
+
+  test_romulus::skinny_bitsliced_tbc<uint8_t>();
+  test_romulus::skinny_bitsliced_tbc<uint16_t>();
+  test_romulus::skinny_bitsliced_tbc<uint32_t>();
+  test_romulus::skinny_bitsliced_tbc<uint64_t>();
+  test_romulus::skinny_tbc_many();
+  test_romulus::skinny_tbc_many_key_schedule();
+  std::cout << "[test] Bitsliced Skinny-128-384+ TBC" << std::endl;
+
+  test_romulus::skinny_simd_tbc();
+  std::cout << "[test] Vectorized Skinny-128-384+ TBC" << std::endl;
+
+  test_romulus::skinny_tbc_key_schedule();
+  std::cout << "[test] Skinny-128-384+ TBC with precomputed key schedule"
+            << std::endl;
+
+  test_romulus::skinny_tbc_tweakey_schedule();
+  std::cout << "[test] Skinny-128-384+ TBC with precomputed tweakey schedule"
+            << std::endl;
+
+  test_romulus::skinny_tbc2();
+  std::cout << "[test] Skinny-128-384+ TBC on two blocks with same tweakey"
+            << std::endl;
+
+  test_romulus::skinny_tbc2x2();
+  std::cout << "[test] Skinny-128-384+ TBC on two pairs of blocks, in lockstep"
+            << std::endl;
+
+  test_romulus::skinny_tbc2_tk1();
+  std::cout << "[test] Skinny-128-384+ TBC on same block with two tweakeys"
+            << std::endl;
+
+  test_romulus::skinny_tbc_pair();
+  std::cout << "[test] Skinny-128-384+ TBC on two states sharing key schedule"
+            << std::endl;
+
+  test_romulus::romulus_lfsr();
+  std::cout << "[test] Packed 56 -bit LFSR with jump ahead" << std::endl;
+
+  test_romulus::romulusn_context();
+  std::cout << "[test] Romulus-N AEAD with precomputed context" << std::endl;
+
+  test_romulus::romulusn_stream();
+  std::cout << "[test] Incremental Romulus-N AEAD" << std::endl;
+
+  test_romulus::romulusn_batch();
+  std::cout << "[test] Romulus-N AEAD on batch of messages" << std::endl;
+
+  test_romulus::romulusm_interleaved();
+  std::cout << "[test] Romulus-M AEAD with interleaved decryption" << std::endl;
+
+  test_romulus::romulusm_fused();
+  std::cout << "[test] Romulus-M AEAD on inputs longer than fused window"
+            << std::endl;
+
+  test_romulus::ad_snapshot();
+  std::cout << "[test] Romulus-{N, M, T} AEAD with absorbed associated data"
+            << std::endl;
+
+  test_romulus::segmented_aead(romulus_segmented::aead_t::romulusn);
+  test_romulus::segmented_aead(romulus_segmented::aead_t::romulusm);
+  test_romulus::segmented_aead(romulus_segmented::aead_t::romulust);
+  std::cout << "[test] Segmented Romulus-{N, M, T} AEAD" << std::endl;
+
+  test_romulus::segmented_nonce();
+  std::cout << "[test] Segmented Romulus AEAD nonce derivation" << std::endl;
+
+  test_romulus::segmented_zero_seg_len();
+  std::cout << "[test] Segmented Romulus AEAD with zero segment length"
+            << std::endl;
+
+  test_romulus::romulust_pipelined();
+  std::cout << "[test] Pipelined Romulus-T AEAD" << std::endl;
+
+  test_romulus::romulush_hasher();
+  std::cout << "[test] Incremental Romulus-H hasher" << std::endl;
+
+  test_romulus::romulush_hash_many();
+  std::cout << "[test] Romulus-H on many messages" << std::endl;
+
+  test_romulus::romulus_treehash();
+  std::cout << "[test] Romulus-H tree hashing mode" << std::endl;
+
+  return EXIT_SUCCESS;
+}
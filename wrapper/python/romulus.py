@@ -6,14 +6,35 @@
   here; then all function calls are forwarded to respective C++
   implementation, executed on host CPU.
 
+  Inputs can be any object supporting buffer protocol ( say bytes, bytearray,
+  memoryview, mmap, numpy array ), which is passed to C++ implementation
+  without being copied. Outputs are written into caller provided writable
+  buffers, when given, otherwise into freshly allocated buffers, which are
+  returned as immutable bytes. Function signatures are set up once, when this
+  module is imported, while ctypes releases GIL for duration of each call, so
+  that calls made from many Python threads run concurrently.
+
   Author: Anjan Roy <hello@itzmeanjan.in>
-  
+
   Project: https://github.com/itzmeanjan/romulus
 """
 
-from typing import Tuple
-from ctypes import c_size_t, CDLL, c_bool
-import numpy as np
+from typing import Tuple, Optional, Any
+from ctypes import (
+    CDLL,
+    Structure,
+    POINTER,
+    byref,
+    pythonapi,
+    py_object,
+    c_bool,
+    c_char_p,
+    c_int,
+    c_size_t,
+    c_ssize_t,
+    c_void_p,
+)
+from contextlib import ExitStack
 from posixpath import exists, abspath
 
 SO_PATH: str = abspath("../libromulus.so")
@@ -21,235 +42,280 @@ assert exists(SO_PATH), "Use `make lib` to generate shared library object !"
 
 SO_LIB: CDLL = CDLL(SO_PATH)
 
-u8 = np.uint8
+ptr_t = c_void_p
 len_t = c_size_t
-uint8_tp = np.ctypeslib.ndpointer(dtype=u8, ndim=1, flags="CONTIGUOUS")
 bool_t = c_bool
 
+# hash( msg, mlen, digest )
+SO_LIB.romulus_hash.argtypes = [ptr_t, len_t, ptr_t]
+SO_LIB.romulus_hash.restype = None
+
+for scheme in ("romulusn", "romulusm", "romulust"):
+    # encrypt( key, nonce, data, dlen, text, cipher, ctlen, tag )
+    enc_fn = getattr(SO_LIB, f"{scheme}_encrypt")
+    enc_fn.argtypes = [ptr_t, ptr_t, ptr_t, len_t, ptr_t, ptr_t, len_t, ptr_t]
+    enc_fn.restype = None
+
+    # decrypt( key, nonce, tag, data, dlen, cipher, text, ctlen )
+    dec_fn = getattr(SO_LIB, f"{scheme}_decrypt")
+    dec_fn.argtypes = [ptr_t, ptr_t, ptr_t, ptr_t, len_t, ptr_t, ptr_t, len_t]
+    dec_fn.restype = bool_t
+
 
-def romulush(msg: bytes) -> bytes:
+class Py_buffer(Structure):
     """
-    Given a N ( >= 0 ) -bytes input message, this function computes 32 -bytes
-    Romulus-H cryptographic hash
+    CPython's buffer view, filled by `PyObject_GetBuffer`, see
+    https://docs.python.org/3/c-api/buffer.html#c.Py_buffer
     """
-    m_len = len(msg)
-    msg_ = np.frombuffer(msg, dtype=u8)
-    digest = np.empty(32, dtype=u8)
 
-    args = [uint8_tp, len_t, uint8_tp]
-    SO_LIB.romulus_hash.argtypes = args
+    _fields_ = [
+        ("buf", c_void_p),
+        ("obj", c_void_p),
+        ("len", c_ssize_t),
+        ("itemsize", c_ssize_t),
+        ("readonly", c_int),
+        ("ndim", c_int),
+        ("format", c_char_p),
+        ("shape", POINTER(c_ssize_t)),
+        ("strides", POINTER(c_ssize_t)),
+        ("suboffsets", POINTER(c_ssize_t)),
+        ("internal", c_void_p),
+    ]
 
-    SO_LIB.romulus_hash(msg_, m_len, digest)
 
-    digest_ = digest.tobytes()
-    return digest_
+PyBUF_SIMPLE = 0
+PyBUF_WRITABLE = 1
 
+pythonapi.PyObject_GetBuffer.argtypes = [py_object, POINTER(Py_buffer), c_int]
+pythonapi.PyObject_GetBuffer.restype = c_int
+pythonapi.PyBuffer_Release.argtypes = [POINTER(Py_buffer)]
+pythonapi.PyBuffer_Release.restype = None
 
-def romulusn_encrypt(
-    key: bytes, nonce: bytes, data: bytes, text: bytes
-) -> Tuple[bytes, bytes]:
+
+class _View:
     """
-    Encrypts M ( >=0 ) -bytes plain text, with Romulus-N AEAD,
-    while using 16 -bytes secret key, 16 -bytes public message nonce &
-    N ( >=0 ) -bytes associated data, while producing M -bytes cipher text
-    & 16 -bytes authentication tag ( in order )
+    Holds C-contiguous buffer of an object, for duration of `with` block, so
+    that its memory can be handed to C++ implementation, without copying
     """
-    assert len(key) == 16, "Romulus-N takes 16 -bytes secret key !"
-    assert len(nonce) == 16, "Romulus-N takes 16 -bytes nonce !"
 
-    ad_len = len(data)
-    ct_len = len(text)
+    def __init__(self, obj: Any, writable: bool = False):
+        self.obj = obj
+        self.flags = PyBUF_WRITABLE if writable else PyBUF_SIMPLE
+        self.view = Py_buffer()
 
-    key_ = np.frombuffer(key, dtype=u8)
-    nonce_ = np.frombuffer(nonce, dtype=u8)
-    data_ = np.frombuffer(data, dtype=u8)
-    text_ = np.frombuffer(text, dtype=u8)
-    enc = np.empty(ct_len, dtype=u8)
-    tag = np.empty(16, dtype=u8)
+    def __enter__(self):
+        pythonapi.PyObject_GetBuffer(self.obj, byref(self.view), self.flags)
+        return self
 
-    args = [uint8_tp, uint8_tp, uint8_tp, len_t, uint8_tp, uint8_tp, len_t, uint8_tp]
-    SO_LIB.romulusn_encrypt.argtypes = args
+    def __exit__(self, *_):
+        pythonapi.PyBuffer_Release(byref(self.view))
 
-    SO_LIB.romulusn_encrypt(key_, nonce_, data_, ad_len, text_, enc, ct_len, tag)
+    @property
+    def ptr(self) -> int:
+        return self.view.buf
 
-    enc_ = enc.tobytes()
-    tag_ = tag.tobytes()
+    @property
+    def len(self) -> int:
+        return self.view.len
 
-    return enc_, tag_
 
+def _output(out: Optional[Any], olen: int, what: str) -> Any:
+    """
+    Returns caller provided output buffer, after checking its length, or
+    allocates a fresh one
+    """
+    if out is None:
+        return bytearray(olen)
 
-def romulusn_decrypt(
-    key: bytes, nonce: bytes, tag: bytes, data: bytes, enc: bytes
-) -> Tuple[bool, bytes]:
+    olen_ = memoryview(out).nbytes
+    assert olen_ == olen, f"{what} buffer must be {olen} -bytes !"
+    return out
+
+
+def _result(buf: Any, out: Optional[Any]) -> Any:
     """
-    Decrypts M ( >=0 ) -bytes cipher text, with Romulus-N AEAD,
-    while using 16 -bytes secret key, 16 -bytes public message nonce,
-    16 -bytes authentication tag & N ( >=0 ) -bytes associated data, while
-    producing boolean flag denoting verification status ( which must hold truth
-    value, check before consuming decrypted output bytes ) & M -bytes
-    plain text ( in order )
+    Returns caller provided output buffer as is, or freshly allocated one, see
+    `_output`, as immutable bytes
     """
-    assert len(key) == 16, "Romulus-N takes 16 -bytes secret key !"
-    assert len(nonce) == 16, "Romulus-N takes 16 -bytes nonce !"
-    assert len(tag) == 16, "Romulus-N takes 16 -bytes authentication tag !"
+    return buf if out is not None else bytes(buf)
 
-    ad_len = len(data)
-    ct_len = len(enc)
 
-    key_ = np.frombuffer(key, dtype=u8)
-    nonce_ = np.frombuffer(nonce, dtype=u8)
-    tag_ = np.frombuffer(tag, dtype=u8)
-    data_ = np.frombuffer(data, dtype=u8)
-    enc_ = np.frombuffer(enc, dtype=u8)
-    dec = np.empty(ct_len, dtype=u8)
+def romulush(msg: Any, digest: Optional[Any] = None) -> Any:
+    """
+    Given a N ( >= 0 ) -bytes input message, this function computes 32 -bytes
+    Romulus-H cryptographic hash, written into `digest`, when provided
+    """
+    md = _output(digest, 32, "Digest")
 
-    args = [uint8_tp, uint8_tp, uint8_tp, uint8_tp, len_t, uint8_tp, uint8_tp, len_t]
-    SO_LIB.romulusn_decrypt.argtypes = args
-    SO_LIB.romulusn_decrypt.restype = bool_t
+    with _View(msg) as m, _View(md, True) as d:
+        SO_LIB.romulus_hash(m.ptr, m.len, d.ptr)
 
-    f = SO_LIB.romulusn_decrypt(key_, nonce_, tag_, data_, ad_len, enc_, dec, ct_len)
+    return _result(md, digest)
 
-    dec_ = dec.tobytes()
 
-    return f, dec_
+def _encrypt(
+    name: str,
+    key: Any,
+    nonce: Any,
+    data: Any,
+    text: Any,
+    cipher: Optional[Any],
+    tag: Optional[Any],
+) -> Tuple[Any, Any]:
+    fn = getattr(SO_LIB, f"{name}_encrypt")
 
+    with ExitStack() as stack:
+        views = (_View(x) for x in (key, nonce, data, text))
+        k, n, d, t = (stack.enter_context(v) for v in views)
 
-def romulusm_encrypt(
-    key: bytes, nonce: bytes, data: bytes, text: bytes
-) -> Tuple[bytes, bytes]:
-    """
-    Encrypts M ( >=0 ) -bytes plain text, with Romulus-M AEAD,
-    while using 16 -bytes secret key, 16 -bytes public message nonce &
-    N ( >=0 ) -bytes associated data, while producing M -bytes cipher text
-    & 16 -bytes authentication tag ( in order )
-    """
-    assert len(key) == 16, "Romulus-M takes 16 -bytes secret key !"
-    assert len(nonce) == 16, "Romulus-M takes 16 -bytes nonce !"
+        assert k.len == 16, f"{name} takes 16 -bytes secret key !"
+        assert n.len == 16, f"{name} takes 16 -bytes nonce !"
 
-    ad_len = len(data)
-    ct_len = len(text)
+        enc = _output(cipher, t.len, "Cipher text")
+        tag_ = _output(tag, 16, "Tag")
 
-    key_ = np.frombuffer(key, dtype=u8)
-    nonce_ = np.frombuffer(nonce, dtype=u8)
-    data_ = np.frombuffer(data, dtype=u8)
-    text_ = np.frombuffer(text, dtype=u8)
-    enc = np.empty(ct_len, dtype=u8)
-    tag = np.empty(16, dtype=u8)
+        with _View(enc, True) as c, _View(tag_, True) as g:
+            fn(k.ptr, n.ptr, d.ptr, d.len, t.ptr, c.ptr, t.len, g.ptr)
 
-    args = [uint8_tp, uint8_tp, uint8_tp, len_t, uint8_tp, uint8_tp, len_t, uint8_tp]
-    SO_LIB.romulusm_encrypt.argtypes = args
+    return _result(enc, cipher), _result(tag_, tag)
 
-    SO_LIB.romulusm_encrypt(key_, nonce_, data_, ad_len, text_, enc, ct_len, tag)
 
-    enc_ = enc.tobytes()
-    tag_ = tag.tobytes()
+def _decrypt(
+    name: str,
+    key: Any,
+    nonce: Any,
+    tag: Any,
+    data: Any,
+    enc: Any,
+    text: Optional[Any],
+) -> Tuple[bool, Any]:
+    fn = getattr(SO_LIB, f"{name}_decrypt")
 
-    return enc_, tag_
+    with ExitStack() as stack:
+        views = (_View(x) for x in (key, nonce, tag, data, enc))
+        k, n, g, d, c = (stack.enter_context(v) for v in views)
 
+        assert k.len == 16, f"{name} takes 16 -bytes secret key !"
+        assert n.len == 16, f"{name} takes 16 -bytes nonce !"
+        assert g.len == 16, f"{name} takes 16 -bytes authentication tag !"
 
-def romulusm_decrypt(
-    key: bytes, nonce: bytes, tag: bytes, data: bytes, enc: bytes
-) -> Tuple[bool, bytes]:
+        dec = _output(text, c.len, "Plain text")
+
+        with _View(dec, True) as t:
+            f = fn(k.ptr, n.ptr, g.ptr, d.ptr, d.len, c.ptr, t.ptr, c.len)
+
+    return f, _result(dec, text)
+
+
+def romulusn_encrypt(
+    key: Any,
+    nonce: Any,
+    data: Any,
+    text: Any,
+    cipher: Optional[Any] = None,
+    tag: Optional[Any] = None,
+) -> Tuple[Any, Any]:
     """
-    Decrypts M ( >=0 ) -bytes cipher text, with Romulus-M AEAD,
+    Encrypts M ( >=0 ) -bytes plain text, with Romulus-N AEAD,
+    while using 16 -bytes secret key, 16 -bytes public message nonce &
+    N ( >=0 ) -bytes associated data, while producing M -bytes cipher text
+    & 16 -bytes authentication tag ( in order ), written into `cipher` & `tag`,
+    when provided
+    """
+    return _encrypt("romulusn", key, nonce, data, text, cipher, tag)
+
+
+def romulusn_decrypt(
+    key: Any,
+    nonce: Any,
+    tag: Any,
+    data: Any,
+    enc: Any,
+    text: Optional[Any] = None,
+) -> Tuple[bool, Any]:
+    """
+    Decrypts M ( >=0 ) -bytes cipher text, with Romulus-N AEAD,
     while using 16 -bytes secret key, 16 -bytes public message nonce,
     16 -bytes authentication tag & N ( >=0 ) -bytes associated data, while
     producing boolean flag denoting verification status ( which must hold truth
     value, check before consuming decrypted output bytes ) & M -bytes
-    plain text ( in order )
+    plain text ( in order ), written into `text`, when provided
     """
-    assert len(key) == 16, "Romulus-M takes 16 -bytes secret key !"
-    assert len(nonce) == 16, "Romulus-M takes 16 -bytes nonce !"
-    assert len(tag) == 16, "Romulus-M takes 16 -bytes authentication tag !"
-
-    ad_len = len(data)
-    ct_len = len(enc)
+    return _decrypt("romulusn", key, nonce, tag, data, enc, text)
 
-    key_ = np.frombuffer(key, dtype=u8)
-    nonce_ = np.frombuffer(nonce, dtype=u8)
-    tag_ = np.frombuffer(tag, dtype=u8)
-    data_ = np.frombuffer(data, dtype=u8)
-    enc_ = np.frombuffer(enc, dtype=u8)
-    dec = np.empty(ct_len, dtype=u8)
 
-    args = [uint8_tp, uint8_tp, uint8_tp, uint8_tp, len_t, uint8_tp, uint8_tp, len_t]
-    SO_LIB.romulusm_decrypt.argtypes = args
-    SO_LIB.romulusm_decrypt.restype = bool_t
-
-    f = SO_LIB.romulusm_decrypt(key_, nonce_, tag_, data_, ad_len, enc_, dec, ct_len)
+def romulusm_encrypt(
+    key: Any,
+    nonce: Any,
+    data: Any,
+    text: Any,
+    cipher: Optional[Any] = None,
+    tag: Optional[Any] = None,
+) -> Tuple[Any, Any]:
+    """
+    Encrypts M ( >=0 ) -bytes plain text, with Romulus-M AEAD,
+    while using 16 -bytes secret key, 16 -bytes public message nonce &
+    N ( >=0 ) -bytes associated data, while producing M -bytes cipher text
+    & 16 -bytes authentication tag ( in order ), written into `cipher` & `tag`,
+    when provided
+    """
+    return _encrypt("romulusm", key, nonce, data, text, cipher, tag)
 
-    dec_ = dec.tobytes()
 
-    return f, dec_
+def romulusm_decrypt(
+    key: Any,
+    nonce: Any,
+    tag: Any,
+    data: Any,
+    enc: Any,
+    text: Optional[Any] = None,
+) -> Tuple[bool, Any]:
+    """
+    Decrypts M ( >=0 ) -bytes cipher text, with Romulus-M AEAD,
+    while using 16 -bytes secret key, 16 -bytes public message nonce,
+    16 -bytes authentication tag & N ( >=0 ) -bytes associated data, while
+    producing boolean flag denoting verification status ( which must hold truth
+    value, check before consuming decrypted output bytes ) & M -bytes
+    plain text ( in order ), written into `text`, when provided
+    """
+    return _decrypt("romulusm", key, nonce, tag, data, enc, text)
 
 
 def romulust_encrypt(
-    key: bytes, nonce: bytes, data: bytes, text: bytes
-) -> Tuple[bytes, bytes]:
+    key: Any,
+    nonce: Any,
+    data: Any,
+    text: Any,
+    cipher: Optional[Any] = None,
+    tag: Optional[Any] = None,
+) -> Tuple[Any, Any]:
     """
     Encrypts M ( >=0 ) -bytes plain text, with Romulus-T AEAD,
     while using 16 -bytes secret key, 16 -bytes public message nonce &
     N ( >=0 ) -bytes associated data, while producing M -bytes cipher text
-    & 16 -bytes authentication tag ( in order )
+    & 16 -bytes authentication tag ( in order ), written into `cipher` & `tag`,
+    when provided
     """
-    assert len(key) == 16, "Romulus-T takes 16 -bytes secret key !"
-    assert len(nonce) == 16, "Romulus-T takes 16 -bytes nonce !"
-
-    ad_len = len(data)
-    ct_len = len(text)
-
-    key_ = np.frombuffer(key, dtype=u8)
-    nonce_ = np.frombuffer(nonce, dtype=u8)
-    data_ = np.frombuffer(data, dtype=u8)
-    text_ = np.frombuffer(text, dtype=u8)
-    enc = np.empty(ct_len, dtype=u8)
-    tag = np.empty(16, dtype=u8)
-
-    args = [uint8_tp, uint8_tp, uint8_tp, len_t, uint8_tp, uint8_tp, len_t, uint8_tp]
-    SO_LIB.romulust_encrypt.argtypes = args
-
-    SO_LIB.romulust_encrypt(key_, nonce_, data_, ad_len, text_, enc, ct_len, tag)
-
-    enc_ = enc.tobytes()
-    tag_ = tag.tobytes()
-
-    return enc_, tag_
+    return _encrypt("romulust", key, nonce, data, text, cipher, tag)
 
 
 def romulust_decrypt(
-    key: bytes, nonce: bytes, tag: bytes, data: bytes, enc: bytes
-) -> Tuple[bool, bytes]:
+    key: Any,
+    nonce: Any,
+    tag: Any,
+    data: Any,
+    enc: Any,
+    text: Optional[Any] = None,
+) -> Tuple[bool, Any]:
     """
     Decrypts M ( >=0 ) -bytes cipher text, with Romulus-T AEAD,
     while using 16 -bytes secret key, 16 -bytes public message nonce,
     16 -bytes authentication tag & N ( >=0 ) -bytes associated data, while
     producing boolean flag denoting verification status ( which must hold truth
     value, check before consuming decrypted output bytes ) & M -bytes
-    plain text ( in order )
+    plain text ( in order ), written into `text`, when provided
     """
-    assert len(key) == 16, "Romulus-T takes 16 -bytes secret key !"
-    assert len(nonce) == 16, "Romulus-T takes 16 -bytes nonce !"
-    assert len(tag) == 16, "Romulus-T takes 16 -bytes authentication tag !"
-
-    ad_len = len(data)
-    ct_len = len(enc)
-
-    key_ = np.frombuffer(key, dtype=u8)
-    nonce_ = np.frombuffer(nonce, dtype=u8)
-    tag_ = np.frombuffer(tag, dtype=u8)
-    data_ = np.frombuffer(data, dtype=u8)
-    enc_ = np.frombuffer(enc, dtype=u8)
-    dec = np.empty(ct_len, dtype=u8)
-
-    args = [uint8_tp, uint8_tp, uint8_tp, uint8_tp, len_t, uint8_tp, uint8_tp, len_t]
-    SO_LIB.romulust_decrypt.argtypes = args
-    SO_LIB.romulust_decrypt.restype = bool_t
-
-    f = SO_LIB.romulust_decrypt(key_, nonce_, tag_, data_, ad_len, enc_, dec, ct_len)
-
-    dec_ = dec.tobytes()
-
-    return f, dec_
+    return _decrypt("romulust", key, nonce, tag, data, enc, text)
 
 
 if __name__ == "__main__":
@@ -1,9 +1,9 @@
 #!/usr/bin/python3
 
 import romulus
-import numpy as np
-
-u8 = np.uint8
+import mmap
+from concurrent.futures import ThreadPoolExecutor
+from os import urandom
 
 
 def test_romulush_kat():
@@ -257,5 +257,48 @@ def test_romulust_kat():
             fd.readline()
 
 
+def test_buffer_protocol():
+    """
+    Tests that any buffer-protocol object can be used as input and that caller
+    provided output buffers are written in place, computing same output as
+    default path does, when called from many threads
+    """
+    for scheme in ("romulusn", "romulusm", "romulust"):
+        encrypt = getattr(romulus, f"{scheme}_encrypt")
+        decrypt = getattr(romulus, f"{scheme}_decrypt")
+
+        key = urandom(16)
+        nonce = bytearray(urandom(16))
+        data = memoryview(urandom(64))[7:40]
+        text = urandom(1 << 16)
+
+        txt = mmap.mmap(-1, len(text))
+        txt.write(text)
+
+        cipher, tag = encrypt(key, nonce, data, text)
+        assert isinstance(cipher, bytes) and isinstance(tag, bytes)
+
+        cipher_ = bytearray(len(text))
+        tag_ = memoryview(bytearray(32))[8:24]
+
+        encrypt(key, nonce, data, txt, cipher_, tag_)
+        assert cipher == cipher_ and tag == tag_
+
+        def open_one(_):
+            dec = bytearray(len(cipher))
+            flag, _ = decrypt(key, nonce, tag, data, memoryview(cipher), dec)
+            return flag and dec == text
+
+        with ThreadPoolExecutor(4) as pool:
+            assert all(pool.map(open_one, range(16)))
+
+        txt.close()
+
+    digest = bytearray(32)
+    assert romulus.romulush(text, digest) is digest
+    assert digest == romulus.romulush(memoryview(text))
+    assert isinstance(romulus.romulush(text), bytes)
+
+
 if __name__ == "__main__":
     print("Execute test cases using `pytest`")